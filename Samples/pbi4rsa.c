@@ -2,7 +2,7 @@
  * Name:        pbi4rsa.c
  * Description: Portable big integer library for RSA.
  * Author:      cosh.cage#hotmail.com
- * File ID:     0525251833H1101251048L00717
+ * File ID:     0525251833H1019261600L00715
  * License:     GPLv3.
  */
 
@@ -348,7 +348,7 @@ static bool _pbrXGCD(P_BINT or, P_BINT os, P_BINT ot, P_BINT a, P_BINT b)
 		
 	while (! pbkIsBintEqualToZero(&R))
 	{
-		if (! pbkDivideBint(&Q, NULL, or, &R))
+		if (! pbkDivBint(&Q, or, &R))
 			goto Lbl_Error;
 		
 		if (! pbkMoveBint(&W, &R))
@@ -432,11 +432,11 @@ static bool _pbrD(P_BINT d, P_BINT e, P_BINT f)
 	if (! (1 == GETABS(GETFLAG(&G)) && 1 == *G.data))
 		goto Lbl_Error;
 		
-	if (! pbkDivideBint(NULL, &T, d, f))
+	if (! pbkModBint(&T, d, f))
 		goto Lbl_Error;
 	if (! pbkAddBint(&G, &T, f))
 		goto Lbl_Error;
-	if (! pbkDivideBint(NULL, &T, &G, f))
+	if (! pbkModBint(&T, &G, f))
 		goto Lbl_Error;
 	if (! pbkMoveBint(d, &T))
 		goto Lbl_Error;
@@ -663,7 +663,7 @@ P_RSA_CIPHER pbrEncrypt(P_RSA_KEY pubk, unsigned char * s, size_t len)
  */
 unsigned char * pbrDecrypt(size_t * plen, P_RSA_CIPHER  prc, P_RSA_KEY pvtk)
 {
-	BINT M = { 0 }, D = { 0 };	
+	BINT M = { 0 };
 	
 	register size_t i, j;
 	
@@ -674,7 +674,6 @@ unsigned char * pbrDecrypt(size_t * plen, P_RSA_CIPHER  prc, P_RSA_KEY pvtk)
 	P_RSA_CIPHER ppp = prc;
 	
 	pbkInitBint(&M, 0);
-	pbkInitBint(&D, 0);
 	pbkReallocBint(&M, GETABS(GETFLAG(&pvtk->N)), false);
 
 	while (NULL != ppp)
@@ -691,8 +690,7 @@ unsigned char * pbrDecrypt(size_t * plen, P_RSA_CIPHER  prc, P_RSA_KEY pvtk)
 		
 		while (NULL != ppp)
 		{
-			pbkMoveBint(&D, &pvtk->D);
-			pbmBintExponentialModuleBint(&M, &ppp->M, &D, &pvtk->N);
+			pbmBintExponentialModuleBint(&M, &ppp->M, &pvtk->D, &pvtk->N);
 			pbkReallocBint(&M, GETABS(GETFLAG(&pvtk->N)), false);
 
 			for (i = 0; i < GETABS(GETFLAG(&M)); ++i)
@@ -0,0 +1,153 @@
+/*
+ * Name:        pbtune.c
+ * Description: Measure algorithm thresholds of the portable big integer library on this host.
+ * Author:      cosh.cage#hotmail.com
+ * License:     GPLv3.
+ * Tip:         Paste the output into pbk.h, or pass it to the compiler by -D options.
+ *              Programs can also assign the values to gTuneTable at runtime.
+ *              Run "pbtune n" to measure parallel thresholds with n workers too.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "pbb.h"
+#include "pbp.h"
+
+#define MIN_CLOCKS (CLOCKS_PER_SEC / 20) /* Minimum time of each measurement. */
+#define NEVER      ((_ub)1 << (UB_BIT - 2))
+
+_ub * a, * b, * c;
+BNUM d = { 0 };
+bool bdiv = false;  /* true: Measure 2n by n division. false: Measure n by n multiplication. */
+bool bconv = false; /* true: Measure decimal conversion of n blocks. */
+PBKTUNE deft;       /* Default thresholds compiled into the library. */
+
+/* Time one operation under the current thresholds. */
+double Measure(size_t n)
+{
+	clock_t start = clock(), now;
+	size_t i = 0;
+	do
+	{
+		if (bconv)
+		{
+			BINT x = { 0 };
+			SETFLAG(&x, (_ib)n);
+			SETSIZE(&x, (_ub)n);
+			x.data = a;
+			pbkBintToDecimalBnum(&d, &x);
+		}
+		else if (bdiv)
+			pbbDivide(c, NULL, a, 2 * n, b, n);
+		else
+			pbbMultiply(c, a, n, b, n);
+		++i;
+		now = clock();
+	}
+	while (now - start < MIN_CLOCKS);
+	return (double)(now - start) / i;
+}
+
+/* Find the smallest size from which the method controlled by pthr wins twice in a row.
+ * If it never wins below hi, the crossover is unknown and the default is kept unless it is below hi.
+ */
+_ub FindThreshold(_ub * pthr, _ub def, _ub lo, _ub hi)
+{
+	_ub n, wins = 0, first = hi;
+	for (n = lo; n < hi; n += n / 8 + 1)
+	{
+		double tnew, told;
+
+		*pthr = n;
+		tnew = Measure(n);
+		*pthr = n + 1;
+		told = Measure(n);
+
+		if (tnew < told)
+		{
+			if (0 == wins++)
+				first = n;
+			if (wins >= 2)
+				return first;
+		}
+		else
+			wins = 0;
+	}
+	fprintf(stderr, "No crossover below %u, using %u. ", hi, GETMAX(def, hi));
+	return GETMAX(def, hi);
+}
+
+int main(int argc, char * argv[])
+{
+	size_t i, max = 1 << 16;
+
+	a = (_ub *)malloc(max * sizeof(_ub));
+	b = (_ub *)malloc(max * sizeof(_ub));
+	c = (_ub *)malloc(2 * max * sizeof(_ub));
+	if (NULL == a || NULL == b || NULL == c || !pbkInitBnum(&d, 10))
+		return 1;
+	deft = gTuneTable;
+
+	srand((unsigned)time(NULL));
+	for (i = 0; i < max; ++i)
+	{
+		a[i] = (_ub)rand() * (_ub)rand();
+		b[i] = (_ub)rand() * (_ub)rand() | 1;
+	}
+
+	gTuneTable.multoom = NEVER;
+	gTuneTable.mulfft  = NEVER;
+	gTuneTable.mulkara = FindThreshold(&gTuneTable.mulkara, deft.mulkara, 4, 512);
+	fprintf(stderr, "Karatsuba: %u\n", gTuneTable.mulkara);
+
+	gTuneTable.multoom = FindThreshold(&gTuneTable.multoom, deft.multoom, GETMAX(gTuneTable.mulkara, 5), 4096);
+	fprintf(stderr, "Toom-3:    %u\n", gTuneTable.multoom);
+
+	gTuneTable.mulfft = FindThreshold(&gTuneTable.mulfft, deft.mulfft, gTuneTable.multoom, (_ub)max);
+	fprintf(stderr, "FFT:       %u\n", gTuneTable.mulfft);
+
+	bdiv = true;
+	gTuneTable.divnewton = NEVER;
+	gTuneTable.divbz = FindThreshold(&gTuneTable.divbz, deft.divbz, 8, 1024);
+	fprintf(stderr, "BZ:        %u\n", gTuneTable.divbz);
+
+	gTuneTable.divnewton = FindThreshold(&gTuneTable.divnewton, deft.divnewton, GETMAX(gTuneTable.divbz, 64), (_ub)max / 2);
+	fprintf(stderr, "Newton:    %u\n", gTuneTable.divnewton);
+	bdiv = false;
+
+	bconv = true;
+	gTuneTable.convdc = FindThreshold(&gTuneTable.convdc, deft.convdc, 4, 1024);
+	fprintf(stderr, "Radix D&C: %u\n", gTuneTable.convdc);
+	bconv = false;
+
+	if (argc > 1 && pbpStartPool((size_t)atoi(argv[1])))
+	{
+		gTuneTable.mulpfft = NEVER;
+		gTuneTable.mulpar = FindThreshold(&gTuneTable.mulpar, deft.mulpar, 64, (_ub)max);
+		fprintf(stderr, "Parallel:  %u\n", gTuneTable.mulpar);
+
+		gTuneTable.mulpfft = FindThreshold(&gTuneTable.mulpfft, deft.mulpfft, GETMAX(gTuneTable.mulpar, gTuneTable.mulfft), (_ub)max);
+		fprintf(stderr, "Pool FFT:  %u\n", gTuneTable.mulpfft);
+		pbpStopPool();
+	}
+
+	printf("/* Thresholds measured by pbtune. */\n");
+	printf("#define BINT_MUL_KARA   %uU\n", gTuneTable.mulkara);
+	printf("#define BINT_MUL_TOOM   %uU\n", gTuneTable.multoom);
+	printf("#define BINT_MUL_FFT    %uU\n", gTuneTable.mulfft);
+	printf("#define BINT_DIV_BZ     %uU\n", gTuneTable.divbz);
+	printf("#define BINT_DIV_NEWTON %uU\n", gTuneTable.divnewton);
+	printf("#define BINT_CONV_DC    %uU\n", gTuneTable.convdc);
+	if (argc > 1)
+	{
+		printf("#define BINT_MUL_PAR    %uU\n", gTuneTable.mulpar);
+		printf("#define BINT_MUL_PFFT   %uU\n", gTuneTable.mulpfft);
+	}
+
+	free(a);
+	free(b);
+	free(c);
+	pbkFreeBnum(&d);
+	return 0;
+}
+
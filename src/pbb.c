@@ -0,0 +1,2172 @@
+﻿/*
+ * Name:        pbb.c
+ * Description: Portable big integer library block arithmetic.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     1019261030B1019261805L02172
+ * License:     GPLv3.
+ */
+
+#include "pbb.h"
+#include "pbp.h"
+#include <stdlib.h> /* Using function malloc, free. */
+#include <string.h> /* Using function memcpy, memmove, memset. */
+
+/* Divide <u1, u0> by the normalized divisor d with reciprocal v; u1 < d.
+ * q receives the quotient and r the remainder. Only multiplications are used.
+ * The first correction is taken about half of the time, so it is done by a mask.
+ */
+#define _PBB_DIV_PREINV(q, r, u1, u0, d, v) do { \
+	register _udb _p = (_udb)(v) * (u1) + ((((_udb)(u1) + 1) << UB_BIT) | (u0)); \
+	register _ub _m; \
+	(q) = (_ub)(_p >> UB_BIT); \
+	(r) = (_ub)((u0) - (q) * (d)); \
+	_m = (_ub)0 - (_ub)((r) > (_ub)_p); \
+	(q) += _m; \
+	(r) += _m & (d); \
+	if ((r) >= (d)) \
+	{ \
+		++(q); \
+		(r) -= (d); \
+	} \
+} while (0)
+
+/* A sub-product that can run on the worker pool. */
+typedef struct st_PBBJOB
+{
+	PBPTASK     task;
+	_ub *       c;
+	const _ub * a;
+	const _ub * b;
+	size_t      n;
+	bool        bok;
+} PBBJOB, * P_PBBJOB;
+
+/* A band of columns of a product. */
+typedef struct st_PBBBAND
+{
+	_ub *       c;  /* Result. Block 0 is column lo. */
+	size_t      lc; /* Number of blocks of c. */
+	const _ub * a;
+	const _ub * b;
+	size_t      lo; /* Lowest column. */
+	size_t      hi; /* Highest column. */
+	_ub *       ws; /* Scratch blocks for a full product. */
+} PBBBAND, * P_PBBBAND;
+
+/* File level function declarations. */
+static size_t _pbbItch           (size_t n, bool bsqr);
+static bool   _pbbAbsDiff        (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+static void   _pbbAddAt          (_ub * c, size_t lc, const _ub * a, size_t la);
+static void   _pbbMulBalanced    (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws);
+static void   _pbbSqrBalanced    (_ub * c, const _ub * a, size_t n, _ub * ws);
+static void   _pbbKaratsubaCompose(_ub * c, size_t n, const _ub * t, _ub * u, bool bneg);
+static void   _pbbMulKaratsuba   (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws);
+static void   _pbbSqrKaratsuba   (_ub * c, const _ub * a, size_t n, _ub * ws);
+static bool   _pbbToom3Evaluate  (_ub * p1, _ub * pm1, _ub * p2, const _ub * a, size_t k, size_t r);
+static void   _pbbToom3Interpolate(_ub * c, size_t n, size_t k, size_t r, _ub * v1, _ub * vm1, _ub * v2, bool bneg);
+static void   _pbbMulToom3       (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws);
+static void   _pbbSqrToom3       (_ub * c, const _ub * a, size_t n, _ub * ws);
+static void   _pbbMulTask        (void * arg, P_PBPWORKER pw);
+static bool   _pbbMulParallel    (_ub * c, const _ub * a, const _ub * b, size_t n, P_PBPWORKER pw);
+static bool   _pbbMulChunk       (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws, P_PBPWORKER pw);
+static bool   _pbbMultiply       (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, P_PBPWORKER pw);
+static bool   _pbbSquare         (_ub * c, const _ub * a, size_t n, P_PBPWORKER pw);
+static size_t _pbbShortItch      (size_t n);
+static bool   _pbbMulLowRec      (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws);
+static bool   _pbbMulHighRec     (_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws);
+static bool   _pbbMulBand        (P_PBBBAND pb, size_t i0, size_t i1, size_t j0, size_t j1);
+static void   _pbbDivideKnuth    (_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n);
+static int    _pbbCompareLong    (const _ub * a, size_t la, const _ub * b, size_t lb);
+static bool   _pbbDivideNewton   (_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n);
+static bool   _pbbDivideInverse  (_ub * q, _ub * an, size_t ln, const _ub * bn, const _ub * x, size_t n);
+static bool   _pbbDiv3n2n        (_ub * q, _ub * a, const _ub * b, size_t h, _ub * ws);
+static bool   _pbbDiv2n1n        (_ub * q, _ub * a, const _ub * b, size_t n, _ub * ws);
+static bool   _pbbDivideBZ       (_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n);
+static bool   _pbbDivideNormal   (_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n);
+
+/* Function name: pbbAdd
+ * Description:   Adds two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la blocks to store the sum.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b.
+ * Return value:  Carry out of the highest block.
+ * Caution:       la shall be greater than or equal to lb.
+ * Tip:           c := a + b; c may equal to a or b.
+ */
+_ub pbbAdd(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register size_t i;
+	register _udb s = 0;
+	for (i = 0; i < lb; ++i)
+	{
+		s = (_udb)a[i] + b[i] + CARRY(s);
+		c[i] = (_ub)s;
+	}
+	for (; i < la && CARRY(s); ++i)
+	{
+		s = (_udb)a[i] + CARRY(s);
+		c[i] = (_ub)s;
+	}
+	if (c != a && i < la) /* No carry is left. */
+		memcpy(c + i, a + i, (la - i) * sizeof(_ub));
+	return (_ub)CARRY(s);
+}
+
+/* Function name: pbbSubtract
+ * Description:   Subtracts two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la blocks to store the difference.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b.
+ * Return value:  Borrow out of the highest block.
+ * Caution:       la shall be greater than or equal to lb.
+ * Tip:           c := a - b; c may equal to a or b.
+ */
+_ub pbbSubtract(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register size_t i;
+	register _udb d;
+	register _ub borrow = 0;
+	for (i = 0; i < lb; ++i)
+	{
+		d = (_udb)a[i] - b[i] - borrow;
+		c[i] = (_ub)d;
+		borrow = (_ub)CARRY(d) & 1;
+	}
+	for (; i < la && borrow; ++i)
+	{
+		d = (_udb)a[i] - borrow;
+		c[i] = (_ub)d;
+		borrow = (_ub)CARRY(d) & 1;
+	}
+	if (c != a && i < la) /* No borrow is left. */
+		memcpy(c + i, a + i, (la - i) * sizeof(_ub));
+	return borrow;
+}
+
+/* Function name: pbbCompare
+ * Description:   Compare two block arrays of the same length.
+ * Parameters:
+ *          a Pointer to a block array.
+ *          b Pointer to another block array.
+ *          n Number of blocks.
+ * Return value:  0:  a == b.
+ *                1:  a > b.
+ *                -1: a < b.
+ */
+int pbbCompare(const _ub * a, const _ub * b, size_t n)
+{
+	while (n > 0)
+	{
+		--n;
+		if (a[n] != b[n])
+			return a[n] > b[n] ? 1 : -1;
+	}
+	return 0;
+}
+
+/* Function name: pbbLeftShift
+ * Description:   Left shift a block array by less than one block.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *       bits Bits to shift. 0 < bits < UB_BIT.
+ * Return value:  Bits shifted out of the highest block.
+ * Tip:           c may equal to a.
+ */
+_ub pbbLeftShift(_ub * c, const _ub * a, size_t n, _ub bits)
+{
+	register _ub hi, lo, r = a[n - 1] >> (UB_BIT - bits);
+	for (hi = a[n - 1]; --n > 0; hi = lo)
+	{
+		lo = a[n - 1];
+		c[n] = (hi << bits) | (lo >> (UB_BIT - bits));
+	}
+	c[0] = hi << bits;
+	return r;
+}
+
+/* Function name: pbbRightShift
+ * Description:   Right shift a block array by less than one block.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *       bits Bits to shift. 0 < bits < UB_BIT.
+ * Return value:  Bits shifted out of the lowest block, kept in the high end of a block.
+ * Tip:           c may equal to a.
+ */
+_ub pbbRightShift(_ub * c, const _ub * a, size_t n, _ub bits)
+{
+	register size_t i;
+	register _ub lo, hi, r = a[0] << (UB_BIT - bits);
+	for (i = 0, lo = a[0]; i + 1 < n; ++i, lo = hi)
+	{
+		hi = a[i + 1];
+		c[i] = (lo >> bits) | (hi << (UB_BIT - bits));
+	}
+	c[i] = lo >> bits;
+	return r;
+}
+
+/* Function name: pbbMultiply1
+ * Description:   Multiplies a block array by a block.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the product.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *          b Multiplier.
+ * Return value:  The highest block of the product.
+ * Tip:           c := a * b; c may equal to a.
+ */
+_ub pbbMultiply1(_ub * c, const _ub * a, size_t n, _ub b)
+{
+	register size_t i;
+	register _udb t = 0;
+	for (i = 0; i < n; ++i)
+	{
+		t = (_udb)a[i] * b + CARRY(t);
+		c[i] = (_ub)t;
+	}
+	return (_ub)CARRY(t);
+}
+
+/* Function name: pbbAddMultiply1
+ * Description:   Multiplies a block array by a block and adds the product to another block array.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to accumulate.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *          b Multiplier.
+ * Return value:  Carry out of the highest block.
+ * Tip:           c := c + a * b;
+ */
+_ub pbbAddMultiply1(_ub * c, const _ub * a, size_t n, _ub b)
+{
+	register size_t i;
+	register _udb t = 0;
+	for (i = 0; i < n; ++i)
+	{
+		t = (_udb)a[i] * b + c[i] + CARRY(t);
+		c[i] = (_ub)t;
+	}
+	return (_ub)CARRY(t);
+}
+
+/* Function name: pbbSubtractMultiply1
+ * Description:   Multiplies a block array by a block and subtracts the product from another block array.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to be subtracted.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *          b Multiplier.
+ * Return value:  Borrow out of the highest block.
+ * Tip:           c := c - a * b;
+ */
+_ub pbbSubtractMultiply1(_ub * c, const _ub * a, size_t n, _ub b)
+{
+	register size_t i;
+	register _udb t;
+	register _ub x, borrow = 0;
+	for (i = 0; i < n; ++i)
+	{
+		t = (_udb)a[i] * b + borrow;
+		x = c[i];
+		c[i] = x - (_ub)t;
+		borrow = (_ub)CARRY(t) + (x < (_ub)t);
+	}
+	return borrow;
+}
+
+/* Function name: pbbDivide1
+ * Description:   Divides a block array by a block.
+ * Parameters:
+ *          q Pointer to a block array of n blocks to store the quotient. This value can be NULL.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *          d Divisor. It shall not be 0.
+ * Return value:  Remainder.
+ * Tip:           q := a / d; q may equal to a.
+ *                The reciprocal of d is computed once, see pbbDivide1Inv.
+ */
+_ub pbbDivide1(_ub * q, const _ub * a, size_t n, _ub d)
+{
+	PBBINV1 inv;
+	pbbInvert1(&inv, d);
+	return pbbDivide1Inv(q, a, n, &inv);
+}
+
+/* Function name: pbbDivideBy3
+ * Description:   Divides a block array by 3 exactly.
+ * Parameters:
+ *          q Pointer to a block array of n blocks to store the quotient.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ * Return value:  0 if a is a multiple of 3, otherwise non-zero.
+ * Tip:           q := a / 3; q may equal to a.
+ *                Each block is multiplied by the inverse of 3 modulo B from the
+ *                lowest block up. No division is done.
+ */
+_ub pbbDivideBy3(_ub * q, const _ub * a, size_t n)
+{
+	register size_t i;
+	register _ub c = 0, s, l, inv = UBLOCK_FULL / 3 * 2 + 1;
+	for (i = 0; i < n; ++i)
+	{
+		s = a[i];
+		l = s - c;
+		c = s < c;
+		l *= inv;
+		q[i] = l;
+		c += (l > UBLOCK_FULL / 3) + (l > UBLOCK_FULL / 3 * 2);
+	}
+	return c;
+}
+
+/* Function name: pbbDivideExact
+ * Description:   Divides two block arrays when the remainder is known to be 0.
+ * Parameters:
+ *          q Pointer to a block array of la - lb + 1 blocks to store the quotient.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. 0 < lb <= la.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest block of b shall not be 0. b shall divide a, otherwise q is garbage.
+ *                The address of q shall not equal to b.
+ * Tip:           q := a / b; q may equal to a.
+ *                Hensel division: the factors of 2 are removed from b, then each
+ *                quotient block is the lowest block of the remainder times the inverse
+ *                of b modulo B. It runs from the lowest block up and needs no estimate.
+ *                From gTuneTable.divbz blocks of divisor and quotient pbbDivide is used.
+ */
+bool pbbDivideExact(_ub * q, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register size_t i, m, qn;
+	register _ub s = 0, d, inv;
+	_ub * r, * bs, t;
+
+	/* Zero blocks under b are zero in a too. */
+	for (m = 0; 0 == b[m]; ++m)
+		;
+	a += m;
+	b += m;
+	la -= m;
+	lb -= m;
+	qn = la - lb + 1;
+
+	if (1 == lb && 3 == b[0])
+	{
+		pbbDivideBy3(q, a, la);
+		return true;
+	}
+	if (lb >= gTuneTable.divbz && qn >= gTuneTable.divbz)
+		return pbbDivide(q, NULL, a, la, b, lb);
+
+	if (NULL == (r = (_ub *)malloc((la + lb) * sizeof(_ub))))
+		return false;
+	for (d = b[0]; !(d & 1); d >>= 1)
+		++s;
+	if (s > 0)
+	{
+		bs = r + la;
+		pbbRightShift(r, a, la, s);
+		pbbRightShift(bs, b, lb, s);
+	}
+	else
+	{
+		bs = (_ub *)b;
+		memcpy(r, a, la * sizeof(_ub));
+	}
+
+	/* inv := 1 / d mod B; Each Newton step doubles the correct low bits. */
+	d = bs[0];
+	inv = (3 * d) ^ 2;
+	for (i = 5; i < UB_BIT; i <<= 1)
+		inv *= 2 - d * inv;
+
+	for (i = 0; i < qn; ++i)
+	{
+		q[i] = r[i] * inv;
+		m = GETMIN(lb, la - i);
+		t = pbbSubtractMultiply1(r + i, bs, m, q[i]);
+		if (0 != t && i + m < la)
+			pbbSubtract(r + i + m, r + i + m, la - i - m, &t, 1);
+	}
+
+	free(r);
+	return true;
+}
+
+/* Function name: pbbInvert1
+ * Description:   Precomputes the reciprocal of a block.
+ * Parameters:
+ *         pi Pointer to a reciprocal structure to be filled.
+ *          d Divisor. It shall not be 0.
+ * Return value:  N/A.
+ * Tip:           This costs one hardware division. Reuse pi for every number
+ *                divided by the same d.
+ */
+void pbbInvert1(P_PBBINV1 pi, _ub d)
+{
+	for (pi->s = 0; !(d & ((_ub)1 << (UB_BIT - 1))); d <<= 1)
+		++pi->s;
+	pi->d = d;
+	pi->v = (_ub)((((_udb)~d << UB_BIT) | UBLOCK_FULL) / d);
+}
+
+/* Function name: pbbDivide1Inv
+ * Description:   Divides a block array by a block with a precomputed reciprocal.
+ * Parameters:
+ *          q Pointer to a block array of n blocks to store the quotient. This value can be NULL.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *         pi Pointer to the reciprocal of the divisor made by pbbInvert1.
+ * Return value:  Remainder.
+ * Tip:           q := a / d; q may equal to a.
+ *                Moller-Granlund division by invariant integers. Each block costs two
+ *                multiplications and no hardware division. The dividend is shifted
+ *                by pi->s bits on the fly.
+ */
+_ub pbbDivide1Inv(_ub * q, const _ub * a, size_t n, const PBBINV1 * pi)
+{
+	register _ub d = pi->d, v = pi->v, s = pi->s, r, u0, qh;
+
+	if (0 == n)
+		return 0;
+	r = (a[n - 1] >> 1) >> (UB_BIT - 1 - s);
+	while (n > 0)
+	{
+		--n;
+		u0 = a[n] << s;
+		if (n > 0)
+			u0 |= (a[n - 1] >> 1) >> (UB_BIT - 1 - s);
+		_PBB_DIV_PREINV(qh, r, r, u0, d, v);
+		if (NULL != q)
+			q[n] = qh;
+	}
+	return r >> s;
+}
+
+/* Function name: pbbModulo1Multi
+ * Description:   Computes remainders of a block array modulo several blocks in one pass.
+ * Parameters:
+ *          r Pointer to k blocks to store the remainders.
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ *         pi Pointer to k reciprocals made by pbbInvert1.
+ *          k Number of divisors.
+ * Return value:  N/A.
+ * Tip:           r[j] := a mod d[j]; Each block of a is loaded once for all divisors.
+ *                Multiply small primes into one block to test many of them at once.
+ */
+void pbbModulo1Multi(_ub * r, const _ub * a, size_t n, const PBBINV1 * pi, size_t k)
+{
+	register size_t i, j;
+	register _ub hi, lo, s, u0, qh;
+
+	if (0 == n)
+	{
+		memset(r, 0, k * sizeof(_ub));
+		return;
+	}
+	for (j = 0; j < k; ++j)
+		r[j] = (a[n - 1] >> 1) >> (UB_BIT - 1 - pi[j].s);
+	for (i = n; i > 0; --i)
+	{
+		hi = a[i - 1];
+		lo = i > 1 ? a[i - 2] >> 1 : 0;
+		for (j = 0; j < k; ++j)
+		{
+			s = pi[j].s;
+			u0 = (hi << s) | (lo >> (UB_BIT - 1 - s));
+			_PBB_DIV_PREINV(qh, r[j], r[j], u0, pi[j].d, pi[j].v);
+		}
+	}
+	for (j = 0; j < k; ++j)
+		r[j] >>= pi[j].s;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDivideKnuth
+ * Description:   Divides a normalized block array by Knuth's Algorithm D.
+ * Parameters:
+ *          q Pointer to a block array of ln - n blocks to store the quotient. This value can be NULL.
+ *         an Pointer to the dividend of ln blocks. The remainder is left in its lowest n blocks.
+ *         ln Number of blocks of an.
+ *         bn Pointer to the divisor whose highest bit is set.
+ *          n Number of blocks of bn. 1 < n < ln.
+ * Return value:  N/A.
+ * Caution:       The highest n blocks of an shall be less than bn.
+ * Tip:           Each quotient block is estimated from the top two blocks of the
+ *                remainder and the top block of the divisor, refined by the second
+ *                block of the divisor, and corrected at most once.
+ */
+static void _pbbDivideKnuth(_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n)
+{
+	register size_t j = ln - n;
+	register _ub d1 = bn[n - 1], d2 = bn[n - 2], qh;
+	register _udb t, rh;
+
+	do
+	{
+		--j;
+		t = ((_udb)an[j + n] << UB_BIT) | an[j + n - 1];
+		if (an[j + n] >= d1)
+		{
+			qh = UBLOCK_FULL;
+			rh = t - (_udb)qh * d1;
+		}
+		else
+		{
+			qh = (_ub)(t / d1);
+			rh = t % d1;
+		}
+		while (!CARRY(rh) && (_udb)qh * d2 > ((rh << UB_BIT) | an[j + n - 2]))
+		{
+			--qh;
+			rh += d1;
+		}
+
+		t = pbbSubtractMultiply1(an + j, bn, n, qh);
+		if (an[j + n] < t) /* Estimate is one too large. */
+		{
+			--qh;
+			pbbAdd(an + j, an + j, n, bn, n);
+		}
+		an[j + n] = 0;
+		if (NULL != q)
+			q[j] = qh;
+	}
+	while (j > 0);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDivideNormal
+ * Description:   Divides a normalized block array by the method that suits the sizes.
+ * Parameters:
+ *          q Pointer to a block array of ln - n blocks to store the quotient. This value can be NULL.
+ *         an Pointer to the dividend of ln blocks. The remainder is left in its lowest n blocks.
+ *         ln Number of blocks of an.
+ *         bn Pointer to the divisor whose highest bit is set.
+ *          n Number of blocks of bn. 1 < n < ln.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest n blocks of an shall be less than bn.
+ */
+static bool _pbbDivideNormal(_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n)
+{
+	register size_t m = GETMIN(n, ln - n);
+
+	if (m >= gTuneTable.divnewton)
+		return _pbbDivideNewton(q, an, ln, bn, n);
+	else if (m >= gTuneTable.divbz)
+		return _pbbDivideBZ(q, an, ln, bn, n);
+	_pbbDivideKnuth(q, an, ln, bn, n);
+	return true;
+}
+
+/* Function name: pbbDivide
+ * Description:   Divides two block arrays.
+ * Parameters:
+ *          q Pointer to a block array of la - lb + 1 blocks to store the quotient. This value can be NULL.
+ *          r Pointer to a block array of lb blocks to store the remainder. This value can be NULL.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. 0 < lb <= la.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest block of b shall not be 0.
+ * Tip:           q := a / b; r := a mod b;
+ *                q and r may equal to a or b, but q shall not equal to r.
+ *                Knuth's Algorithm D is used unless both the divisor and the quotient
+ *                reach gTuneTable.divbz blocks. From there Burnikel-Ziegler recursive
+ *                division is used, and from gTuneTable.divnewton blocks the quotient
+ *                is computed by multiplications with the reciprocal of the divisor.
+ */
+bool pbbDivide(_ub * q, _ub * r, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register _ub s = 0, d;
+	_ub * an, * bn;
+	bool bok = true;
+
+	if (1 == lb)
+	{
+		s = pbbDivide1(q, a, la, b[0]);
+		if (NULL != r)
+			r[0] = s;
+		return true;
+	}
+
+	if (NULL == (an = (_ub *)malloc((la + 1 + lb) * sizeof(_ub))))
+		return false;
+	bn = an + la + 1;
+
+	/* Normalize so that the highest bit of the divisor is set. */
+	for (d = b[lb - 1]; !(d & ((_ub)1 << (UB_BIT - 1))); d <<= 1)
+		++s;
+	if (s > 0)
+	{
+		pbbLeftShift(bn, b, lb, s);
+		an[la] = pbbLeftShift(an, a, la, s);
+	}
+	else
+	{
+		memcpy(bn, b, lb * sizeof(_ub));
+		memcpy(an, a, la * sizeof(_ub));
+		an[la] = 0;
+	}
+
+	bok = _pbbDivideNormal(q, an, la + 1, bn, lb);
+	if (bok && NULL != r)
+	{
+		if (s > 0)
+			pbbRightShift(r, an, lb, s);
+		else
+			memcpy(r, an, lb * sizeof(_ub));
+	}
+
+	free(an);
+	return bok;
+}
+
+/* Function name: pbbMultiplyBasecase
+ * Description:   Multiplies two block arrays by schoolbook method.
+ * Parameters:
+ *          c Pointer to a block array of la + lb blocks to store the product.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a. la > 0.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. lb > 0.
+ * Return value:  N/A.
+ * Caution:       The address of c shall not overlap a or b.
+ * Tip:           c := a * b;
+ */
+void pbbMultiplyBasecase(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register size_t j;
+	c[la] = pbbMultiply1(c, a, la, b[0]);
+	for (j = 1; j < lb; ++j)
+		c[la + j] = pbbAddMultiply1(c + j, a, la, b[j]);
+}
+
+/* Function name: pbbSquareBasecase
+ * Description:   Squares a block array by schoolbook method.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 0.
+ * Return value:  N/A.
+ * Caution:       The address of c shall not overlap a.
+ * Tip:           c := a * a;
+ *                Every cross product is computed once and doubled.
+ */
+void pbbSquareBasecase(_ub * c, const _ub * a, size_t n)
+{
+	register size_t i;
+	register _udb p, s, carry = 0;
+
+	if (1 == n)
+	{
+		p = (_udb)a[0] * a[0];
+		c[0] = (_ub)p;
+		c[1] = (_ub)CARRY(p);
+		return;
+	}
+
+	/* Cross products. */
+	c[0] = 0;
+	c[n] = pbbMultiply1(c + 1, a + 1, n - 1, a[0]);
+	for (i = 1; i + 1 < n; ++i)
+		c[n + i] = pbbAddMultiply1(c + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+	c[2 * n - 1] = 0;
+	pbbLeftShift(c, c, 2 * n, 1);
+
+	/* Diagonal. */
+	for (i = 0; i < n; ++i)
+	{
+		p = (_udb)a[i] * a[i];
+		s = (_udb)c[2 * i] + (_ub)p + carry;
+		c[2 * i] = (_ub)s;
+		s = (_udb)c[2 * i + 1] + CARRY(p) + CARRY(s);
+		c[2 * i + 1] = (_ub)s;
+		carry = CARRY(s);
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbItch
+ * Description:   Compute scratch blocks that balanced multiplication needs.
+ * Parameters:
+ *          n Number of blocks of each operand.
+ *       bsqr true: Squaring. false: Multiplication.
+ * Return value:  Number of scratch blocks.
+ */
+static size_t _pbbItch(size_t n, bool bsqr)
+{
+	if (n < gTuneTable.mulkara || n < 2)
+		return 0;
+	else if (n < gTuneTable.multoom || n < 5)
+	{
+		register size_t h = n - (n >> 1), i = _pbbItch(h, bsqr), j = _pbbItch(n >> 1, bsqr);
+		return 6 * h + 1 + GETMAX(i, j);
+	}
+	else
+	{
+		register size_t k = (n + 2) / 3, i = _pbbItch(k + 1, bsqr), j = _pbbItch(k, bsqr);
+		/* The short top piece may use Karatsuba while the others use Toom-3 and need less. */
+		j = GETMAX(j, _pbbItch(n - 2 * k, bsqr));
+		return 12 * (k + 1) + GETMAX(i, j);
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbAbsDiff
+ * Description:   Compute the absolute difference of two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la blocks to store |a - b|.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b.
+ * Return value:  true:  a < b.
+ *                false: a >= b.
+ * Caution:       la shall be greater than or equal to lb and la shall not exceed lb + 1.
+ */
+static bool _pbbAbsDiff(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	if (la > lb && a[lb])
+	{
+		pbbSubtract(c, a, la, b, lb);
+		return false;
+	}
+	if (pbbCompare(a, b, lb) >= 0)
+	{
+		pbbSubtract(c, a, lb, b, lb);
+		if (la > lb)
+			c[lb] = 0;
+		return false;
+	}
+	pbbSubtract(c, b, lb, a, lb);
+	if (la > lb)
+		c[lb] = 0;
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbAddAt
+ * Description:   Add a block array into another block array and propagate the carry.
+ * Parameters:
+ *          c Pointer to a block array.
+ *         lc Number of blocks of c from the addition point to the end.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ * Return value:  N/A.
+ * Caution:       The sum shall fit in lc blocks.
+ */
+static void _pbbAddAt(_ub * c, size_t lc, const _ub * a, size_t la)
+{
+	while (la > 0 && 0 == a[la - 1])
+		--la;
+	if (la > 0)
+		pbbAdd(c, c, lc, a, la);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulBalanced
+ * Description:   Multiplies two block arrays of the same length.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the product.
+ *          a Pointer to a block array.
+ *          b Pointer to a block array.
+ *          n Number of blocks of a and b.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ */
+static void _pbbMulBalanced(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	if (n < gTuneTable.mulkara || n < 2)
+		pbbMultiplyBasecase(c, a, n, b, n);
+	else if (n < gTuneTable.multoom || n < 5)
+		_pbbMulKaratsuba(c, a, b, n, ws);
+	else
+		_pbbMulToom3(c, a, b, n, ws);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbSqrBalanced
+ * Description:   Squares a block array.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ */
+static void _pbbSqrBalanced(_ub * c, const _ub * a, size_t n, _ub * ws)
+{
+	if (n < gTuneTable.mulkara || n < 2)
+		pbbSquareBasecase(c, a, n);
+	else if (n < gTuneTable.multoom || n < 5)
+		_pbbSqrKaratsuba(c, a, n, ws);
+	else
+		_pbbSqrToom3(c, a, n, ws);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbKaratsubaCompose
+ * Description:   Compose Karatsuba products.
+ * Parameters:
+ *          c Pointer to 2 * n blocks. It holds z0 at 0 and z2 at 2 * m.
+ *          n Number of blocks of each operand.
+ *          t Pointer to 2 * h blocks of |a1 - a0| * |b1 - b0|.
+ *          u Pointer to 2 * h + 1 scratch blocks.
+ *       bneg true: (a1 - a0) * (b1 - b0) is negative.
+ * Return value:  N/A.
+ * Tip:           m = n / 2; h = n - m;
+ */
+static void _pbbKaratsubaCompose(_ub * c, size_t n, const _ub * t, _ub * u, bool bneg)
+{
+	register size_t m = n >> 1, h = n - m;
+
+	/* u := z0 + z2 -+ t. */
+	memcpy(u, c + 2 * m, 2 * h * sizeof(_ub));
+	u[2 * h] = pbbAdd(u, u, 2 * h, c, 2 * m);
+	if (bneg)
+		u[2 * h] += pbbAdd(u, u, 2 * h, t, 2 * h);
+	else
+		u[2 * h] -= pbbSubtract(u, u, 2 * h, t, 2 * h);
+
+	_pbbAddAt(c + m, 2 * n - m, u, 2 * h + 1);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulKaratsuba
+ * Description:   Multiplies two block arrays by Karatsuba method.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the product.
+ *          a Pointer to a block array.
+ *          b Pointer to a block array.
+ *          n Number of blocks of a and b. n > 1.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ * Tip:           a * b = z2 * B ^ 2m + (z0 + z2 -+ |a1 - a0| * |b1 - b0|) * B ^ m + z0;
+ */
+static void _pbbMulKaratsuba(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	register size_t m = n >> 1, h = n - m;
+	_ub * da = ws, * db = ws + h, * t = ws + 2 * h, * u = ws + 4 * h;
+	bool bneg;
+
+	bneg  = _pbbAbsDiff(da, a + m, h, a, m);
+	bneg ^= _pbbAbsDiff(db, b + m, h, b, m);
+
+	_pbbMulBalanced(c, a, b, m, ws + 6 * h + 1);
+	_pbbMulBalanced(c + 2 * m, a + m, b + m, h, ws + 6 * h + 1);
+	_pbbMulBalanced(t, da, db, h, ws + 6 * h + 1);
+
+	_pbbKaratsubaCompose(c, n, t, u, bneg);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbSqrKaratsuba
+ * Description:   Squares a block array by Karatsuba method.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 1.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ */
+static void _pbbSqrKaratsuba(_ub * c, const _ub * a, size_t n, _ub * ws)
+{
+	register size_t m = n >> 1, h = n - m;
+	_ub * da = ws, * t = ws + 2 * h, * u = ws + 4 * h;
+
+	_pbbAbsDiff(da, a + m, h, a, m);
+
+	_pbbSqrBalanced(c, a, m, ws + 6 * h + 1);
+	_pbbSqrBalanced(c + 2 * m, a + m, h, ws + 6 * h + 1);
+	_pbbSqrBalanced(t, da, h, ws + 6 * h + 1);
+
+	_pbbKaratsubaCompose(c, n, t, u, false);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbToom3Evaluate
+ * Description:   Evaluate a 3-way split operand at points 1, -1 and 2.
+ * Parameters:
+ *         p1 Pointer to k + 1 blocks to store a(1).
+ *        pm1 Pointer to k + 1 blocks to store |a(-1)|.
+ *         p2 Pointer to k + 1 blocks to store a(2).
+ *          a Pointer to a block array of 2 * k + r blocks.
+ *          k Number of blocks of the lower two pieces.
+ *          r Number of blocks of the highest piece.
+ * Return value:  true:  a(-1) < 0.
+ *                false: a(-1) >= 0.
+ */
+static bool _pbbToom3Evaluate(_ub * p1, _ub * pm1, _ub * p2, const _ub * a, size_t k, size_t r)
+{
+	register bool bneg;
+	_ub t;
+
+	/* p1 := a0 + a2; pm1 := |p1 - a1|; p1 := p1 + a1. */
+	p1[k] = pbbAdd(p1, a, k, a + 2 * k, r);
+	if (p1[k] || pbbCompare(p1, a + k, k) >= 0)
+	{
+		pm1[k] = p1[k] - pbbSubtract(pm1, p1, k, a + k, k);
+		bneg = false;
+	}
+	else
+	{
+		pbbSubtract(pm1, a + k, k, p1, k);
+		pm1[k] = 0;
+		bneg = true;
+	}
+	p1[k] += pbbAdd(p1, p1, k, a + k, k);
+
+	/* p2 := a0 + 2 * a1 + 4 * a2. */
+	memcpy(p2, a, k * sizeof(_ub));
+	p2[k] = pbbAddMultiply1(p2, a + k, k, 2);
+	t = pbbAddMultiply1(p2, a + 2 * k, r, 4);
+	pbbAdd(p2 + r, p2 + r, k + 1 - r, &t, 1);
+
+	return bneg;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbToom3Interpolate
+ * Description:   Interpolate Toom-3 products and compose the result.
+ * Parameters:
+ *          c Pointer to 2 * n blocks. It holds a0 * b0 at 0 and a2 * b2 at 4 * k.
+ *          n Number of blocks of each operand.
+ *          k Number of blocks of the lower two pieces.
+ *          r Number of blocks of the highest piece.
+ *         v1 Pointer to 2 * k + 2 blocks of product at point 1.
+ *        vm1 Pointer to 2 * k + 2 blocks of absolute product at point -1.
+ *         v2 Pointer to 2 * k + 2 blocks of product at point 2.
+ *       bneg true: Product at point -1 is negative.
+ * Return value:  N/A.
+ * Tip:           Sequence of operations:
+ *                v2 := (v2 - vm1) / 3; vm1 := (v1 - vm1) / 2; v1 := v1 - v0;
+ *                v2 := (v2 - v1) / 2; v1 := v1 - vm1 - vinf; v2 := v2 - 2 * vinf; vm1 := vm1 - v2;
+ *                Then vm1, v1, v2 are coefficients of B ^ k, B ^ 2k and B ^ 3k.
+ */
+static void _pbbToom3Interpolate(_ub * c, size_t n, size_t k, size_t r, _ub * v1, _ub * vm1, _ub * v2, bool bneg)
+{
+	register size_t l = 2 * k + 2;
+	_ub t;
+	_ub * vinf = c + 4 * k;
+
+	if (bneg)
+	{
+		pbbAdd(v2, v2, l, vm1, l);
+		pbbDivideBy3(v2, v2, l);
+		pbbAdd(vm1, v1, l, vm1, l);
+	}
+	else
+	{
+		pbbSubtract(v2, v2, l, vm1, l);
+		pbbDivideBy3(v2, v2, l);
+		pbbSubtract(vm1, v1, l, vm1, l);
+	}
+	pbbRightShift(vm1, vm1, l, 1);
+	pbbSubtract(v1, v1, l, c, 2 * k);
+	pbbSubtract(v2, v2, l, v1, l);
+	pbbRightShift(v2, v2, l, 1);
+	pbbSubtract(v1, v1, l, vm1, l);
+	pbbSubtract(v1, v1, l, vinf, 2 * r);
+	t = pbbSubtractMultiply1(v2, vinf, 2 * r, 2);
+	pbbSubtract(v2 + 2 * r, v2 + 2 * r, l - 2 * r, &t, 1);
+	pbbSubtract(vm1, vm1, l, v2, l);
+
+	memset(c + 2 * k, 0, 2 * k * sizeof(_ub));
+	_pbbAddAt(c + k, 2 * n - k, vm1, l);
+	_pbbAddAt(c + 2 * k, 2 * n - 2 * k, v1, l);
+	_pbbAddAt(c + 3 * k, 2 * n - 3 * k, v2, l);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulToom3
+ * Description:   Multiplies two block arrays by Toom-3 method.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the product.
+ *          a Pointer to a block array.
+ *          b Pointer to a block array.
+ *          n Number of blocks of a and b. n > 4.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ * Tip:           Operands are evaluated at 0, 1, -1, 2 and infinity.
+ */
+static void _pbbMulToom3(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	register size_t k = (n + 2) / 3, r = n - 2 * k, l = k + 1;
+	_ub * pa1 = ws, * pam1 = ws + l, * pa2 = ws + 2 * l;
+	_ub * pb1 = ws + 3 * l, * pbm1 = ws + 4 * l, * pb2 = ws + 5 * l;
+	_ub * v1 = ws + 6 * l, * vm1 = ws + 8 * l, * v2 = ws + 10 * l, * w = ws + 12 * l;
+	bool bneg;
+
+	bneg  = _pbbToom3Evaluate(pa1, pam1, pa2, a, k, r);
+	bneg ^= _pbbToom3Evaluate(pb1, pbm1, pb2, b, k, r);
+
+	_pbbMulBalanced(c, a, b, k, w);
+	_pbbMulBalanced(c + 4 * k, a + 2 * k, b + 2 * k, r, w);
+	_pbbMulBalanced(v1, pa1, pb1, l, w);
+	_pbbMulBalanced(vm1, pam1, pbm1, l, w);
+	_pbbMulBalanced(v2, pa2, pb2, l, w);
+
+	_pbbToom3Interpolate(c, n, k, r, v1, vm1, v2, bneg);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbSqrToom3
+ * Description:   Squares a block array by Toom-3 method.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 4.
+ *         ws Pointer to scratch blocks, see _pbbItch.
+ * Return value:  N/A.
+ */
+static void _pbbSqrToom3(_ub * c, const _ub * a, size_t n, _ub * ws)
+{
+	register size_t k = (n + 2) / 3, r = n - 2 * k, l = k + 1;
+	_ub * pa1 = ws, * pam1 = ws + l, * pa2 = ws + 2 * l;
+	_ub * v1 = ws + 6 * l, * vm1 = ws + 8 * l, * v2 = ws + 10 * l, * w = ws + 12 * l;
+
+	_pbbToom3Evaluate(pa1, pam1, pa2, a, k, r);
+
+	_pbbSqrBalanced(c, a, k, w);
+	_pbbSqrBalanced(c + 4 * k, a + 2 * k, r, w);
+	_pbbSqrBalanced(v1, pa1, l, w);
+	_pbbSqrBalanced(vm1, pam1, l, w);
+	_pbbSqrBalanced(v2, pa2, l, w);
+
+	_pbbToom3Interpolate(c, n, k, r, v1, vm1, v2, false);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulTask
+ * Description:   Task callback of a parallel sub-product.
+ * Parameters:
+ *        arg Pointer to a PBBJOB.
+ *         pw Pointer to the worker who runs the task.
+ * Return value:  N/A.
+ */
+static void _pbbMulTask(void * arg, P_PBPWORKER pw)
+{
+	P_PBBJOB pj = (P_PBBJOB)arg;
+	pj->bok = _pbbMulParallel(pj->c, pj->a, pj->b, pj->n, pw);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulParallel
+ * Description:   Multiplies two block arrays of the same length on the worker pool.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the product.
+ *          a Pointer to a block array.
+ *          b Pointer to a block array. a == b means squaring.
+ *          n Number of blocks of a and b.
+ *         pw Pointer to the current worker.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           One level of Karatsuba or Toom-3 is split into independent sub-products.
+ *                The first one runs at once and the others are forked for idle workers.
+ *                Below gTuneTable.mulpar a sub-product runs serially.
+ *                Scratch blocks come from the arena of the worker.
+ */
+static bool _pbbMulParallel(_ub * c, const _ub * a, const _ub * b, size_t n, P_PBPWORKER pw)
+{
+	register size_t i, cnt;
+	_ub * ws;
+	PBBJOB job[5];
+	bool bneg, bok = true;
+
+	if (n < gTuneTable.mulpar || n < gTuneTable.mulkara || n < 2)
+	{
+		if (NULL == (ws = (_ub *)pbpAlloc(pw, _pbbItch(n, a == b) * sizeof(_ub))))
+			return false;
+		if (a == b)
+			_pbbSqrBalanced(c, a, n, ws);
+		else
+			_pbbMulBalanced(c, a, b, n, ws);
+		pbpFree(pw, ws);
+		return true;
+	}
+
+	if (n < gTuneTable.multoom || n < 5)
+	{
+		register size_t m = n >> 1, h = n - m;
+		_ub * da, * db;
+
+		if (NULL == (ws = (_ub *)pbpAlloc(pw, (6 * h + 1) * sizeof(_ub))))
+			return false;
+		da = ws, db = ws + h;
+
+		bneg = _pbbAbsDiff(da, a + m, h, a, m);
+		if (a == b)
+		{
+			db = da;
+			bneg = false;
+		}
+		else
+			bneg ^= _pbbAbsDiff(db, b + m, h, b, m);
+
+		job[0].c = c;          job[0].a = a;     job[0].b = b;     job[0].n = m;
+		job[1].c = c + 2 * m;  job[1].a = a + m; job[1].b = b + m; job[1].n = h;
+		job[2].c = ws + 2 * h; job[2].a = da;    job[2].b = db;    job[2].n = h;
+		cnt = 3;
+	}
+	else
+	{
+		register size_t k = (n + 2) / 3, r = n - 2 * k, l = k + 1;
+		_ub * pa1, * pam1, * pa2, * pb1, * pbm1, * pb2;
+
+		if (NULL == (ws = (_ub *)pbpAlloc(pw, 12 * l * sizeof(_ub))))
+			return false;
+		pa1 = ws, pam1 = ws + l, pa2 = ws + 2 * l;
+		pb1 = ws + 3 * l, pbm1 = ws + 4 * l, pb2 = ws + 5 * l;
+
+		bneg = _pbbToom3Evaluate(pa1, pam1, pa2, a, k, r);
+		if (a == b)
+		{
+			pb1 = pa1, pbm1 = pam1, pb2 = pa2;
+			bneg = false;
+		}
+		else
+			bneg ^= _pbbToom3Evaluate(pb1, pbm1, pb2, b, k, r);
+
+		job[0].c = c;           job[0].a = a;         job[0].b = b;         job[0].n = k;
+		job[1].c = c + 4 * k;   job[1].a = a + 2 * k; job[1].b = b + 2 * k; job[1].n = r;
+		job[2].c = ws + 6 * l;  job[2].a = pa1;       job[2].b = pb1;       job[2].n = l;
+		job[3].c = ws + 8 * l;  job[3].a = pam1;      job[3].b = pbm1;      job[3].n = l;
+		job[4].c = ws + 10 * l; job[4].a = pa2;       job[4].b = pb2;       job[4].n = l;
+		cnt = 5;
+	}
+
+	for (i = cnt - 1; i > 0; --i)
+	{
+		job[i].task.func = _pbbMulTask;
+		job[i].task.arg = &job[i];
+		pbpFork(pw, &job[i].task);
+	}
+	job[0].bok = _pbbMulParallel(job[0].c, job[0].a, job[0].b, job[0].n, pw);
+	for (i = 1; i < cnt; ++i)
+	{
+		pbpJoin(pw, &job[i].task);
+		bok = bok && job[i].bok;
+	}
+	bok = bok && job[0].bok;
+
+	if (bok)
+	{
+		if (3 == cnt)
+			_pbbKaratsubaCompose(c, n, job[2].c, job[2].c + 2 * job[2].n, bneg);
+		else
+			_pbbToom3Interpolate(c, n, job[0].n, job[1].n, job[2].c, job[3].c, job[4].c, bneg);
+	}
+
+	pbpFree(pw, ws);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulChunk
+ * Description:   Multiplies two block arrays of the same length serially or on the worker pool.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the product.
+ *          a Pointer to a block array.
+ *          b Pointer to a block array.
+ *          n Number of blocks of a and b.
+ *         ws Pointer to scratch blocks, see _pbbItch. Unused if pw is not NULL.
+ *         pw Pointer to the current worker or NULL.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbbMulChunk(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws, P_PBPWORKER pw)
+{
+	if (NULL != pw)
+		return _pbbMulParallel(c, a, b, n, pw);
+	_pbbMulBalanced(c, a, b, n, ws);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMultiply
+ * Description:   Multiplies two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la + lb blocks to store the product.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a. la > 0.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. lb > 0.
+ *         pw Pointer to the current worker or NULL to run serially.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbbMultiply(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, P_PBPWORKER pw)
+{
+	register size_t i;
+	_ub * ws, * t;
+
+	if (la < lb)
+	{
+		const _ub * x = a;
+		a = b;
+		b = x;
+		i = la;
+		la = lb;
+		lb = i;
+	}
+
+	if (lb < gTuneTable.mulpar)
+		pw = NULL;
+
+	if (a == b && la == lb)
+		return _pbbSquare(c, a, la, pw);
+
+	if (lb < gTuneTable.mulkara)
+	{
+		pbbMultiplyBasecase(c, a, la, b, lb);
+		return true;
+	}
+
+	if (lb >= (NULL == pw ? gTuneTable.mulfft : gTuneTable.mulpfft))
+		return pbbMultiplyFFT(c, a, la, b, lb);
+
+	ws = (_ub *)malloc((2 * lb + (NULL == pw ? _pbbItch(lb, false) : 0)) * sizeof(_ub));
+	if (NULL == ws)
+		return false;
+	t = ws + 2 * lb;
+
+	if (!_pbbMulChunk(c, a, b, lb, t, pw))
+		goto Lbl_Failed;
+	for (i = lb; i + lb <= la; i += lb)
+	{
+		if (!_pbbMulChunk(ws, a + i, b, lb, t, pw))
+			goto Lbl_Failed;
+		memcpy(c + i + lb, ws + lb, lb * sizeof(_ub));
+		pbbAdd(c + i, c + i, 2 * lb, ws, lb);
+	}
+	if (i < la)
+	{
+		if (!_pbbMultiply(ws, b, lb, a + i, la - i, pw))
+			goto Lbl_Failed;
+		memcpy(c + i + lb, ws + lb, (la - i) * sizeof(_ub));
+		pbbAdd(c + i, c + i, la - i + lb, ws, lb);
+	}
+
+	free(ws);
+	return true;
+Lbl_Failed:
+	free(ws);
+	return false;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbSquare
+ * Description:   Squares a block array.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to the current worker or NULL to run serially.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbbSquare(_ub * c, const _ub * a, size_t n, P_PBPWORKER pw)
+{
+	_ub * ws;
+
+	if (n < gTuneTable.mulpar)
+		pw = NULL;
+
+	if (n < gTuneTable.mulkara)
+	{
+		pbbSquareBasecase(c, a, n);
+		return true;
+	}
+
+	if (n >= (NULL == pw ? gTuneTable.mulfft : gTuneTable.mulpfft))
+		return pbbMultiplyFFT(c, a, n, a, n);
+
+	if (NULL != pw)
+		return _pbbMulParallel(c, a, a, n, pw);
+
+	ws = (_ub *)malloc(_pbbItch(n, true) * sizeof(_ub));
+	if (NULL == ws)
+		return false;
+
+	_pbbSqrBalanced(c, a, n, ws);
+
+	free(ws);
+	return true;
+}
+
+/* Function name: pbbMultiply
+ * Description:   Multiplies two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la + lb blocks to store the product.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a. la > 0.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. lb > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a or b.
+ * Tip:           c := a * b;
+ *                Schoolbook, Karatsuba, Toom-3 or FFT method is chosen by the
+ *                length of the shorter operand and thresholds in gTuneTable.
+ *                A longer operand is cut into pieces as long as the shorter one.
+ *                If pbpStartPool has been called, operands of gTuneTable.mulpar
+ *                blocks or more are multiplied by all workers.
+ */
+bool pbbMultiply(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	P_PBPWORKER pw = GETMIN(la, lb) >= gTuneTable.mulpar ? pbpEnter() : NULL;
+	bool bok = _pbbMultiply(c, a, la, b, lb, pw);
+
+	if (NULL != pw)
+		pbpLeave(pw);
+	return bok;
+}
+
+/* Function name: pbbSquare
+ * Description:   Squares a block array.
+ * Parameters:
+ *          c Pointer to a block array of 2 * n blocks to store the square.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a.
+ * Tip:           c := a * a;
+ */
+bool pbbSquare(_ub * c, const _ub * a, size_t n)
+{
+	P_PBPWORKER pw = n >= gTuneTable.mulpar ? pbpEnter() : NULL;
+	bool bok = _pbbSquare(c, a, n, pw);
+
+	if (NULL != pw)
+		pbpLeave(pw);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbShortItch
+ * Description:   Compute scratch blocks that short products need.
+ * Parameters:
+ *          n Number of blocks of each operand.
+ * Return value:  Number of scratch blocks.
+ */
+static size_t _pbbShortItch(size_t n)
+{
+	register size_t p = n * 3 / 10, i;
+
+	if (n < gTuneTable.mulkara || n < 4)
+		return n + 1;
+	i = p + _pbbShortItch(p);
+	return GETMAX(2 * (n - p), i);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulLowRec
+ * Description:   Computes the low half of a product by Mulders' method.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks.
+ *          b Pointer to a block array of n blocks.
+ *          n Number of blocks.
+ *         ws Pointer to scratch blocks, see _pbbShortItch.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           With k = n - p: a0 * b0 of k blocks is a full product.
+ *                The low p blocks of a1 * b0 and a0 * b1 are short products.
+ */
+static bool _pbbMulLowRec(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	register size_t i, p = n * 3 / 10, k = n - p;
+
+	if (n < gTuneTable.mulkara || n < 4)
+	{
+		pbbMultiply1(c, a, n, b[0]);
+		for (i = 1; i < n; ++i)
+			pbbAddMultiply1(c + i, a, n - i, b[i]);
+		return true;
+	}
+
+	if (!pbbMultiply(ws, a, k, b, k))
+		return false;
+	memcpy(c, ws, n * sizeof(_ub));
+
+	if (!_pbbMulLowRec(ws, a + k, b, p, ws + p))
+		return false;
+	pbbAdd(c + k, c + k, p, ws, p);
+	if (!_pbbMulLowRec(ws, a, b + k, p, ws + p))
+		return false;
+	pbbAdd(c + k, c + k, p, ws, p);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulHighRec
+ * Description:   Computes the high half of a product by Mulders' method.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks.
+ *          b Pointer to a block array of n blocks.
+ *          n Number of blocks.
+ *         ws Pointer to scratch blocks, see _pbbShortItch.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           With k = n - p: a1 * b1 of k blocks is a full product.
+ *                The high p blocks of the top p blocks of a1 times b0 and
+ *                b1 times a0 are short products. a0 * b0 is ignored.
+ *                The basecase only sums columns from n - 1 upwards.
+ */
+static bool _pbbMulHighRec(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	register size_t i, p = n * 3 / 10, k = n - p;
+
+	if (n < gTuneTable.mulkara || n < 4)
+	{
+		ws[0] = 0;
+		for (i = 0; i < n; ++i)
+			ws[i + 1] = pbbAddMultiply1(ws, b + n - 1 - i, i + 1, a[i]);
+		memcpy(c, ws + 1, n * sizeof(_ub));
+		return true;
+	}
+
+	if (!pbbMultiply(ws, a + p, k, b + p, k))
+		return false;
+	memcpy(c, ws + n - 2 * p, n * sizeof(_ub));
+
+	if (!_pbbMulHighRec(ws, a + k, b, p, ws + p))
+		return false;
+	pbbAdd(c, c, n, ws, p);
+	if (!_pbbMulHighRec(ws, b + k, a, p, ws + p))
+		return false;
+	pbbAdd(c, c, n, ws, p);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbMulBand
+ * Description:   Adds products of blocks whose column lies in a band.
+ * Parameters:
+ *         pb Pointer to the band.
+ *         i0 First block of a.
+ *         i1 Block of a after the last one.
+ *         j0 First block of b.
+ *         j1 Block of b after the last one.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           For i0 <= i < i1, j0 <= j < j1 and lo <= i + j <= hi:
+ *                c += a[i] * b[j] * B ^ (i + j - lo);
+ *                A rectangle inside the band is a full product. A rectangle
+ *                that crosses the border is halved until it is small.
+ */
+static bool _pbbMulBand(P_PBBBAND pb, size_t i0, size_t i1, size_t j0, size_t j1)
+{
+	register size_t i, j, l, h;
+	_ub t;
+
+	if (i0 + j0 > pb->hi || i1 + j1 - 2 < pb->lo)
+		return true;
+
+	if (i0 + j0 >= pb->lo && i1 + j1 - 2 <= pb->hi)
+	{
+		if (!pbbMultiply(pb->ws, pb->a + i0, i1 - i0, pb->b + j0, j1 - j0))
+			return false;
+		l = i0 + j0 - pb->lo;
+		_pbbAddAt(pb->c + l, pb->lc - l, pb->ws, i1 - i0 + j1 - j0);
+		return true;
+	}
+
+	if (i1 - i0 < gTuneTable.mulkara || j1 - j0 < gTuneTable.mulkara)
+	{
+		for (j = j0; j < j1 && j <= pb->hi; ++j)
+		{
+			l = pb->lo > j ? GETMAX(i0, pb->lo - j) : i0;
+			h = GETMIN(i1, pb->hi - j + 1);
+			if (l < h)
+			{
+				t = pbbAddMultiply1(pb->c + l + j - pb->lo, pb->a + l, h - l, pb->b[j]);
+				i = h + j - pb->lo;
+				_pbbAddAt(pb->c + i, pb->lc - i, &t, 1);
+			}
+		}
+		return true;
+	}
+
+	if (i1 - i0 >= j1 - j0)
+	{
+		i = i0 + (i1 - i0) / 2;
+		return _pbbMulBand(pb, i0, i, j0, j1) && _pbbMulBand(pb, i, i1, j0, j1);
+	}
+	j = j0 + (j1 - j0) / 2;
+	return _pbbMulBand(pb, i0, i1, j0, j) && _pbbMulBand(pb, i0, i1, j, j1);
+}
+
+/* Function name: pbbMulLow
+ * Description:   Computes the low half of the product of two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks.
+ *          b Pointer to a block array of n blocks.
+ *          n Number of blocks. n > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a or b.
+ * Tip:           c := a * b mod B ^ n; B = 2 ^ UB_BIT.
+ *                The result is exact. It costs about half of a full product below
+ *                the Karatsuba threshold and a bit more above it.
+ */
+bool pbbMulLow(_ub * c, const _ub * a, const _ub * b, size_t n)
+{
+	_ub * ws;
+	bool bok;
+
+	if (NULL == (ws = (_ub *)malloc(_pbbShortItch(n) * sizeof(_ub))))
+		return false;
+	bok = _pbbMulLowRec(c, a, b, n, ws);
+	free(ws);
+	return bok;
+}
+
+/* Function name: pbbMulHigh
+ * Description:   Computes the high half of the product of two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks.
+ *          b Pointer to a block array of n blocks.
+ *          n Number of blocks. n > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a or b.
+ *                The result is an approximation:
+ *                floor(a * b / B ^ n) - 2 * n < c <= floor(a * b / B ^ n); B = 2 ^ UB_BIT.
+ * Tip:           Callers that need the exact value shall keep a few guard blocks in
+ *                a and b, or correct the result afterwards as Barrett reduction does.
+ */
+bool pbbMulHigh(_ub * c, const _ub * a, const _ub * b, size_t n)
+{
+	_ub * ws;
+	bool bok;
+
+	if (NULL == (ws = (_ub *)malloc(_pbbShortItch(n) * sizeof(_ub))))
+		return false;
+	bok = _pbbMulHighRec(c, a, b, n, ws);
+	free(ws);
+	return bok;
+}
+
+/* Function name: pbbMulMiddle
+ * Description:   Computes the middle product of two block arrays.
+ * Parameters:
+ *          c Pointer to a block array of la - lb + 3 blocks to store the result.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. 0 < lb <= la.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a or b.
+ * Tip:           c := sum(a[i] * b[j] * B ^ (i + j - lb + 1)) for lb - 1 <= i + j <= la - 1;
+ *                With la = 2 * n - 1 and lb = n, it is the middle n blocks of a * b
+ *                without the carries from the low blocks. Newton iterations use it to
+ *                skip blocks that are already known.
+ *                Below the Karatsuba threshold it costs as much as an n by n product,
+ *                half of the full product. Above it the cost approaches the full product.
+ */
+bool pbbMulMiddle(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	PBBBAND band;
+	bool bok;
+
+	band.c  = c;
+	band.lc = la - lb + 3;
+	band.a  = a;
+	band.b  = b;
+	band.lo = lb - 1;
+	band.hi = la - 1;
+	if (NULL == (band.ws = (_ub *)malloc((la + lb) * sizeof(_ub))))
+		return false;
+
+	memset(c, 0, band.lc * sizeof(_ub));
+	bok = _pbbMulBand(&band, 0, la, 0, lb);
+	free(band.ws);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbCompareLong
+ * Description:   Compare a block array with a shorter one.
+ * Parameters:
+ *          a Pointer to a block array.
+ *         la Number of blocks of a.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. lb <= la.
+ * Return value:  0:  a == b.
+ *                1:  a > b.
+ *                -1: a < b.
+ */
+static int _pbbCompareLong(const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	while (la > lb)
+		if (0 != a[--la])
+			return 1;
+	return pbbCompare(a, b, lb);
+}
+
+/* Function name: pbbInvert
+ * Description:   Computes the reciprocal of a block array by Newton iteration.
+ * Parameters:
+ *          x Pointer to a block array of n + 1 blocks to store the reciprocal.
+ *          b Pointer to a block array.
+ *          n Number of blocks of b. n > 1.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest bit of b shall be set. The address of x shall not overlap b.
+ * Tip:           x := floor(B ^ (2 * n) / b); B ^ n < x <= 2 * B ^ n.
+ *                The reciprocal of the high half of b is lifted to n blocks by one
+ *                Newton step x + x * (B ^ (2 * n) - b * x) / B ^ (2 * n), which doubles
+ *                the precision, and then corrected to the exact value.
+ *                Below gTuneTable.divnewton or 4 blocks B ^ (2 * n) is divided by b
+ *                with Burnikel-Ziegler or Knuth division.
+ */
+bool pbbInvert(_ub * x, const _ub * b, size_t n)
+{
+	register size_t h, l, le, ld, eo, m, i;
+	_ub * ws, * ih, * p, * d, * t, * u, one = 1;
+	bool bneg, rneg, bok = false;
+	int cmp;
+
+	if (n < gTuneTable.divnewton || n < 4)
+	{
+		if (NULL == (ws = (_ub *)malloc((2 * n + 1) * sizeof(_ub))))
+			return false;
+		memset(ws, 0, 2 * n * sizeof(_ub));
+		ws[2 * n] = 1;
+		/* Not _pbbDivideNormal, which would come back here for n < 4 when divnewton is below 4. */
+		if (n >= gTuneTable.divbz)
+			bok = _pbbDivideBZ(x, ws, 2 * n + 1, b, n);
+		else
+		{
+			_pbbDivideKnuth(x, ws, 2 * n + 1, b, n);
+			bok = true;
+		}
+		free(ws);
+		return bok;
+	}
+
+	h = (n + 1) >> 1;
+	l = n - h;
+	m = 2 * n + 2;
+	if (NULL == (ws = (_ub *)malloc((2 * n + 2 * h + 5 + 2 * m) * sizeof(_ub))))
+		return false;
+	ih = ws;
+	p  = ih + h + 1;
+	d  = p + n + h + 1;
+	t  = d + n + 3;
+	u  = t + m;
+
+	/* ih := floor(B ^ (2 * h) / bh); bh is the high h blocks of b. */
+	if (!pbbInvert(ih, b + l, h))
+		goto Lbl_Finish;
+
+	/* e := B ^ (n + h) - b * ih; |e| is about B ^ n. */
+	if (!pbbMultiply(p, b, n, ih, h + 1))
+		goto Lbl_Finish;
+	le = n + h;
+	if (0 != p[le])
+		bneg = true;
+	else
+	{
+		bneg = false;
+		for (i = 0; i < le; ++i)
+			p[i] = ~p[i];
+		pbbAdd(p, p, le, &one, 1);
+	}
+	while (le > 0 && 0 == p[le - 1])
+		--le;
+
+	/* x := ih * B ^ l + d; d := ih * e / B ^ (2 * h) from the high l + 2 blocks of e. */
+	memset(x, 0, l * sizeof(_ub));
+	memcpy(x + l, ih, (h + 1) * sizeof(_ub));
+	ld = 0;
+	if (le > 0)
+	{
+		eo = le > l + 2 ? le - l - 2 : 0;
+		if (!pbbMultiply(d, ih, h + 1, p + eo, le - eo))
+			goto Lbl_Finish;
+		ld = h + 1 + le - eo;
+		if (ld > 2 * h - eo)
+		{
+			ld -= 2 * h - eo;
+			memmove(d, d + 2 * h - eo, ld * sizeof(_ub));
+			while (ld > 0 && 0 == d[ld - 1])
+				--ld;
+		}
+		else
+			ld = 0;
+		if (bneg)
+			pbbSubtract(x, x, n + 1, d, ld);
+		else
+			pbbAdd(x, x, n + 1, d, ld);
+	}
+
+	/* r := B ^ (2 * n) - b * x = +/-(e * B ^ l - b * d); t := |r|; */
+	memset(t, 0, m * sizeof(_ub));
+	memcpy(t + l, p, le * sizeof(_ub));
+	memset(u, 0, m * sizeof(_ub));
+	if (ld > 0 && !pbbMultiply(u, b, n, d, ld))
+		goto Lbl_Finish;
+	cmp = pbbCompare(t, u, m);
+	if (cmp >= 0)
+	{
+		pbbSubtract(t, t, m, u, m);
+		rneg = cmp > 0 && bneg;
+	}
+	else
+	{
+		pbbSubtract(t, u, m, t, m);
+		rneg = !bneg;
+	}
+
+	/* Correct x so that 0 <= r < b. */
+	while (rneg)
+	{
+		pbbSubtract(x, x, n + 1, &one, 1);
+		if (_pbbCompareLong(t, m, b, n) > 0)
+			pbbSubtract(t, t, m, b, n);
+		else
+		{
+			pbbSubtract(t, b, n, t, n);
+			rneg = false;
+		}
+	}
+	while (_pbbCompareLong(t, m, b, n) >= 0)
+	{
+		pbbSubtract(t, t, m, b, n);
+		pbbAdd(x, x, n + 1, &one, 1);
+	}
+	bok = true;
+Lbl_Finish:
+	free(ws);
+	return bok;
+}
+
+/* Function name: pbbInvertN
+ * Description:   Precomputes the reciprocal of a divisor of blocks.
+ * Parameters:
+ *         pi Pointer to a PBBINVN to fill.
+ *          w Pointer to 2 * n + 1 blocks that keep the normalized divisor and its reciprocal.
+ *          b Pointer to a block array.
+ *          n Number of blocks of b. n > 1.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest block of b shall not be 0. w shall live as long as pi.
+ * Tip:           pi->d := b shifted left until its highest bit is set; pi->x := pbbInvert(pi->d);
+ *                Dividing by b many times with pbbDivideInv computes the reciprocal only once.
+ */
+bool pbbInvertN(P_PBBINVN pi, _ub * w, const _ub * b, size_t n)
+{
+	register _ub d;
+
+	pi->d = w;
+	pi->x = w + n;
+	pi->n = n;
+	for (pi->s = 0, d = b[n - 1]; !(d & ((_ub)1 << (UB_BIT - 1))); d <<= 1)
+		++pi->s;
+	if (pi->s > 0)
+		pbbLeftShift(pi->d, b, n, pi->s);
+	else
+		memcpy(pi->d, b, n * sizeof(_ub));
+	return pbbInvert(pi->x, pi->d, n);
+}
+
+/* Function name: pbbDivideInv
+ * Description:   Divides a block array by a divisor with its precomputed reciprocal.
+ * Parameters:
+ *          q Pointer to a block array of la - pi->n + 1 blocks to store the quotient. This value can be NULL.
+ *          r Pointer to a block array of pi->n blocks to store the remainder. This value can be NULL.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a. la >= pi->n.
+ *         pi Pointer to a divisor made by pbbInvertN.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           q := a / b; r := a mod b; q and r may equal to a, but q shall not equal to r.
+ *                From gTuneTable.divnewton blocks the quotient is computed by multiplications
+ *                with pi->x as in pbbDivide, below that pbbDivide is followed.
+ */
+bool pbbDivideInv(_ub * q, _ub * r, const _ub * a, size_t la, const PBBINVN * pi)
+{
+	register size_t n = pi->n;
+	_ub * an;
+	bool bok;
+
+	if (NULL == (an = (_ub *)malloc((la + 1) * sizeof(_ub))))
+		return false;
+	if (pi->s > 0)
+		an[la] = pbbLeftShift(an, a, la, pi->s);
+	else
+	{
+		memcpy(an, a, la * sizeof(_ub));
+		an[la] = 0;
+	}
+
+	if (GETMIN(n, la + 1 - n) >= gTuneTable.divnewton)
+		bok = _pbbDivideInverse(q, an, la + 1, pi->d, pi->x, n);
+	else
+		bok = _pbbDivideNormal(q, an, la + 1, pi->d, n);
+	if (bok && NULL != r)
+	{
+		if (pi->s > 0)
+			pbbRightShift(r, an, n, pi->s);
+		else
+			memcpy(r, an, n * sizeof(_ub));
+	}
+
+	free(an);
+	return bok;
+}
+
+/* Function name: pbbMontgomeryInvert1
+ * Description:   Computes the negative inverse of an odd block modulo B.
+ * Parameter:
+ *          m An odd block.
+ * Return value:  -m ^ -1 mod B.
+ * Tip:           m is its own inverse modulo 8. Each step of x := x * (2 - m * x)
+ *                doubles the correct bits of x.
+ */
+_ub pbbMontgomeryInvert1(_ub m)
+{
+	register _ub x = m;
+	register size_t i;
+	for (i = 3; i < UB_BIT; i <<= 1)
+		x *= 2 - m * x;
+	return (_ub)0 - x;
+}
+
+/* Function name: pbbMontgomeryMultiply
+ * Description:   Multiplies two block arrays and reduces the product by Montgomery's method.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks. a < m.
+ *          b Pointer to a block array of n blocks. b < m.
+ *          m Pointer to an odd modulus of n blocks.
+ *          n Number of blocks. n > 0.
+ *          k -m ^ -1 mod B, see pbbMontgomeryInvert1.
+ *          t Pointer to n + 2 scratch blocks.
+ * Return value:  N/A.
+ * Tip:           c := a * b / B ^ n mod m; c may equal to a or b.
+ *                Coarsely integrated operand scanning (CIOS): each block of b is
+ *                multiplied in and one block is reduced away at once, so the
+ *                partial result never exceeds n + 2 blocks.
+ */
+void pbbMontgomeryMultiply(_ub * c, const _ub * a, const _ub * b, const _ub * m, size_t n, _ub k, _ub * t)
+{
+	register size_t i, j;
+	register _udb u;
+	register _ub q;
+
+	memset(t, 0, (n + 2) * sizeof(_ub));
+	for (i = 0; i < n; ++i)
+	{
+		/* t := t + a * b[i]. */
+		u = (_udb)t[n] + pbbAddMultiply1(t, a, n, b[i]);
+		t[n] = (_ub)u;
+		t[n + 1] = (_ub)CARRY(u);
+
+		/* t := (t + q * m) / B. The lowest block of the sum is 0. */
+		q = t[0] * k;
+		u = (_udb)q * m[0] + t[0];
+		for (j = 1; j < n; ++j)
+		{
+			u = (_udb)q * m[j] + t[j] + CARRY(u);
+			t[j - 1] = (_ub)u;
+		}
+		u = (_udb)t[n] + CARRY(u);
+		t[n - 1] = (_ub)u;
+		t[n] = t[n + 1] + (_ub)CARRY(u);
+	}
+
+	/* t < 2 * m. */
+	if (t[n] || pbbCompare(t, m, n) >= 0)
+		pbbSubtract(c, t, n, m, n);
+	else
+		memcpy(c, t, n * sizeof(_ub));
+}
+
+/* Function name: pbbMontgomeryReduce
+ * Description:   Reduces a block array by Montgomery's method.
+ * Parameters:
+ *          c Pointer to a block array of n blocks to store the result.
+ *          t Pointer to a block array of 2 * n blocks. t < m * B ^ n. It is destroyed.
+ *          m Pointer to an odd modulus of n blocks.
+ *          n Number of blocks. n > 0.
+ *          k -m ^ -1 mod B, see pbbMontgomeryInvert1.
+ * Return value:  N/A.
+ * Tip:           c := t / B ^ n mod m; c may equal to t.
+ *                Use it after pbbMultiply or pbbSquare when n is large enough for
+ *                them to beat pbbMontgomeryMultiply.
+ */
+void pbbMontgomeryReduce(_ub * c, _ub * t, const _ub * m, size_t n, _ub k)
+{
+	register size_t i;
+	register _udb u;
+	register _ub h = 0;
+
+	for (i = 0; i < n; ++i)
+	{
+		u = (_udb)t[i + n] + pbbAddMultiply1(t + i, m, n, t[i] * k) + h;
+		t[i + n] = (_ub)u;
+		h = (_ub)CARRY(u);
+	}
+
+	/* t / B ^ n < 2 * m. */
+	if (h || pbbCompare(t + n, m, n) >= 0)
+		pbbSubtract(c, t + n, n, m, n);
+	else
+		memmove(c, t + n, n * sizeof(_ub));
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDivideNewton
+ * Description:   Divides a normalized block array by the reciprocal of the divisor.
+ * Parameters:
+ *          q Pointer to a block array of ln - n blocks to store the quotient. This value can be NULL.
+ *         an Pointer to the dividend of ln blocks. The remainder is left in its lowest n blocks.
+ *         ln Number of blocks of an.
+ *         bn Pointer to the divisor whose highest bit is set.
+ *          n Number of blocks of bn. 1 < n < ln.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest n blocks of an shall be less than bn.
+ * Tip:           x = floor(B ^ (2 * n) / bn) is computed by pbbInvert, see _pbbDivideInverse.
+ */
+static bool _pbbDivideNewton(_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n)
+{
+	_ub * x;
+	bool bok;
+
+	if (NULL == (x = (_ub *)malloc((n + 1) * sizeof(_ub))))
+		return false;
+	bok = pbbInvert(x, bn, n) && _pbbDivideInverse(q, an, ln, bn, x, n);
+	free(x);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDivideInverse
+ * Description:   Divides a normalized block array by a divisor with its reciprocal.
+ * Parameters:
+ *          q Pointer to a block array of ln - n blocks to store the quotient. This value can be NULL.
+ *         an Pointer to the dividend of ln blocks. The remainder is left in its lowest n blocks.
+ *         ln Number of blocks of an.
+ *         bn Pointer to the divisor whose highest bit is set.
+ *          x Pointer to floor(B ^ (2 * n) / bn) of n + 1 blocks.
+ *          n Number of blocks of bn. 1 < n < ln.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest n blocks of an shall be less than bn.
+ * Tip:           The quotient is produced n blocks at a time from the top. Each piece
+ *                w of n + c blocks is divided by multiplying its high c + 2 blocks by
+ *                the high c + 3 blocks of x. The estimate is never above the true
+ *                quotient and is at most a few units below it.
+ */
+static bool _pbbDivideInverse(_ub * q, _ub * an, size_t ln, const _ub * bn, const _ub * x, size_t n)
+{
+	register size_t j = ln - n, c, gi, oi;
+	_ub * ws, * p, * t, * qh, one = 1;
+	bool bok = false;
+
+	if (NULL == (ws = (_ub *)malloc((4 * n + 3) * sizeof(_ub))))
+		return false;
+	p = ws;
+	t = p + 2 * n + 3;
+
+	while (j > 0)
+	{
+		_ub * w;
+
+		c = GETMIN(n, j);
+		j -= c;
+		w = an + j;
+
+		/* qh := floor(w * x / B ^ (2 * n)) computed from the high blocks only. */
+		gi = GETMIN(c + 3, n + 1);
+		oi = n + 1 - gi;
+		if (!pbbMultiply(p, w + n - 2, c + 2, x + oi, gi))
+			goto Lbl_Finish;
+		qh = p + n + 2 - oi;
+
+		/* w := w - qh * bn; Then add the few missing units. */
+		if (!pbbMultiply(t, bn, n, qh, c))
+			goto Lbl_Finish;
+		pbbSubtract(w, w, n + c, t, n + c);
+		while (_pbbCompareLong(w, n + c, bn, n) >= 0)
+		{
+			pbbSubtract(w, w, n + c, bn, n);
+			pbbAdd(qh, qh, c, &one, 1);
+		}
+		if (NULL != q)
+			memcpy(q + j, qh, c * sizeof(_ub));
+	}
+	bok = true;
+Lbl_Finish:
+	free(ws);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDiv3n2n
+ * Description:   Divides 3 * h blocks by 2 * h blocks.
+ * Parameters:
+ *          q Pointer to a block array of h blocks to store the quotient.
+ *          a Pointer to the dividend of 3 * h blocks. The remainder is left in its lowest 2 * h blocks.
+ *          b Pointer to the divisor of 2 * h blocks whose highest bit is set.
+ *          h Number of blocks of half of the divisor.
+ *         ws Pointer to 2 * h scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest 2 * h blocks of a shall be less than b.
+ * Tip:           The quotient is estimated by dividing the high 2 * h blocks of a by the
+ *                high h blocks of b, then corrected at most twice.
+ */
+static bool _pbbDiv3n2n(_ub * q, _ub * a, const _ub * b, size_t h, _ub * ws)
+{
+	_ub cy, one = 1;
+	_ib net;
+
+	if (pbbCompare(a + 2 * h, b + h, h) < 0)
+	{
+		if (!_pbbDiv2n1n(q, a + h, b + h, h, ws))
+			return false;
+		cy = 0;
+	}
+	else
+	{
+		/* q := B ^ h - 1; The high h blocks of a equal to b1, so r1 := a1 + b1. */
+		memset(q, 0xff, h * sizeof(_ub));
+		cy = pbbAdd(a + h, a + h, h, b + h, h);
+	}
+
+	/* a := r1 * B ^ h + a0 - q * b0; Add b back while it is negative. */
+	if (!pbbMultiply(ws, q, h, b, h))
+		return false;
+	net = (_ib)cy - (_ib)pbbSubtract(a, a, 2 * h, ws, 2 * h);
+	while (net < 0)
+	{
+		net += (_ib)pbbAdd(a, a, 2 * h, b, 2 * h);
+		pbbSubtract(q, q, h, &one, 1);
+	}
+	memset(a + 2 * h, 0, h * sizeof(_ub));
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDiv2n1n
+ * Description:   Divides 2 * n blocks by n blocks.
+ * Parameters:
+ *          q Pointer to a block array of n blocks to store the quotient.
+ *          a Pointer to the dividend of 2 * n blocks. The remainder is left in its lowest n blocks.
+ *          b Pointer to the divisor of n blocks whose highest bit is set.
+ *          n Number of blocks of b.
+ *         ws Pointer to n scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest n blocks of a shall be less than b.
+ */
+static bool _pbbDiv2n1n(_ub * q, _ub * a, const _ub * b, size_t n, _ub * ws)
+{
+	if ((n & 1) || n < gTuneTable.divbz || n < 4)
+	{
+		_pbbDivideKnuth(q, a, 2 * n, b, n);
+		return true;
+	}
+	n >>= 1;
+	if (!_pbbDiv3n2n(q + n, a + n, b, n, ws))
+		return false;
+	return _pbbDiv3n2n(q, a, b, n, ws);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbbDivideBZ
+ * Description:   Divides a normalized block array by Burnikel-Ziegler recursive division.
+ * Parameters:
+ *          q Pointer to a block array of ln - n blocks to store the quotient. This value can be NULL.
+ *         an Pointer to the dividend of ln blocks. The remainder is left in its lowest n blocks.
+ *         ln Number of blocks of an.
+ *         bn Pointer to the divisor whose highest bit is set.
+ *          n Number of blocks of bn. 1 < n < ln.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The highest n blocks of an shall be less than bn.
+ * Tip:           Both operands are shifted up by a few zero blocks so that the divisor
+ *                has m = j * 2 ^ k blocks and halves down to j < gTuneTable.divbz blocks.
+ *                The dividend is then divided m blocks at a time from the top.
+ *                All levels share one scratch area of m blocks for their products.
+ */
+static bool _pbbDivideBZ(_ub * q, _ub * an, size_t ln, const _ub * bn, size_t n)
+{
+	register size_t j = n, k = 0, m, pad, lp, c;
+	_ub * ap, * bp, * qp, * ws;
+	bool bok = true;
+
+	while (j >= gTuneTable.divbz && j >= 4)
+	{
+		j = (j + 1) >> 1;
+		++k;
+	}
+	m = j << k;
+	pad = m - n;
+	lp = ln + pad;
+	c = (lp - m) % m;
+	if (c >= gTuneTable.divbz) /* Zero blocks on the top make a whole piece. */
+	{
+		lp += m - c;
+		c = 0;
+	}
+
+	if (NULL == (ap = (_ub *)malloc((2 * lp + m) * sizeof(_ub))))
+		return false;
+	bp = ap + lp;
+	qp = bp + m;
+	ws = qp + lp - m;
+
+	memset(ap, 0, pad * sizeof(_ub));
+	memcpy(ap + pad, an, ln * sizeof(_ub));
+	memset(ap + pad + ln, 0, (lp - pad - ln) * sizeof(_ub));
+	memset(bp, 0, pad * sizeof(_ub));
+	memcpy(bp + pad, bn, n * sizeof(_ub));
+
+	/* A short piece on the top is cheaper by Algorithm D. */
+	j = lp - m - c;
+	if (c > 0)
+		_pbbDivideKnuth(qp + j, ap + j, m + c, bp, m);
+	while (bok && j > 0)
+	{
+		j -= m;
+		bok = _pbbDiv2n1n(qp + j, ap + j, bp, m, ws);
+	}
+
+	if (bok)
+	{
+		memcpy(an, ap + pad, n * sizeof(_ub));
+		if (NULL != q)
+			memcpy(q, qp, (ln - n) * sizeof(_ub));
+	}
+	free(ap);
+	return bok;
+}
+
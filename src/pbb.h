@@ -0,0 +1,66 @@
+/*
+ * Name:        pbb.h
+ * Description: Portable big integer library block arithmetic.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     1019261030A1019261530L00066
+ * License:     GPLv3.
+ */
+
+#ifndef _PBB_H_
+#define _PBB_H_
+
+#include "pbk.h"
+
+/* A divisor of one block with its precomputed reciprocal. */
+typedef struct st_PBBINV1
+{
+	_ub d; /* Divisor shifted left until its highest bit is set. */
+	_ub v; /* floor((B ^ 2 - 1) / d) - B. */
+	_ub s; /* Bits shifted. */
+} PBBINV1, * P_PBBINV1;
+
+/* A divisor of blocks with its precomputed reciprocal. */
+typedef struct st_PBBINVN
+{
+	_ub *  d; /* Divisor of n blocks shifted left until its highest bit is set. */
+	_ub *  x; /* floor(B ^ (2 * n) / d) of n + 1 blocks. */
+	size_t n; /* Blocks of the divisor. n > 1. */
+	_ub    s; /* Bits shifted. */
+} PBBINVN, * P_PBBINVN;
+
+/* Functions for block arrays.
+ * A block array is a pointer to _ub and a length. The lowest block comes first.
+ * These functions do not allocate the result, callers shall prepare enough space.
+ */
+_ub  pbbAdd               (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+_ub  pbbSubtract          (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+int  pbbCompare           (const _ub * a, const _ub * b, size_t n);
+_ub  pbbLeftShift         (_ub * c, const _ub * a, size_t n, _ub bits);
+_ub  pbbRightShift        (_ub * c, const _ub * a, size_t n, _ub bits);
+_ub  pbbMultiply1         (_ub * c, const _ub * a, size_t n, _ub b);
+_ub  pbbAddMultiply1      (_ub * c, const _ub * a, size_t n, _ub b);
+_ub  pbbSubtractMultiply1 (_ub * c, const _ub * a, size_t n, _ub b);
+_ub  pbbDivide1           (_ub * q, const _ub * a, size_t n, _ub d);
+void pbbInvert1           (P_PBBINV1 pi, _ub d);
+_ub  pbbDivide1Inv        (_ub * q, const _ub * a, size_t n, const PBBINV1 * pi);
+void pbbModulo1Multi      (_ub * r, const _ub * a, size_t n, const PBBINV1 * pi, size_t k);
+bool pbbDivide            (_ub * q, _ub * r, const _ub * a, size_t la, const _ub * b, size_t lb);
+_ub  pbbDivideBy3         (_ub * q, const _ub * a, size_t n);
+bool pbbDivideExact       (_ub * q, const _ub * a, size_t la, const _ub * b, size_t lb);
+void pbbMultiplyBasecase  (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+void pbbSquareBasecase    (_ub * c, const _ub * a, size_t n);
+bool pbbMultiply          (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+bool pbbSquare            (_ub * c, const _ub * a, size_t n);
+bool pbbMultiplyFFT       (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+bool pbbMulLow            (_ub * c, const _ub * a, const _ub * b, size_t n);
+bool pbbMulHigh           (_ub * c, const _ub * a, const _ub * b, size_t n);
+bool pbbMulMiddle         (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb);
+bool pbbInvert            (_ub * x, const _ub * b, size_t n);
+bool pbbInvertN           (P_PBBINVN pi, _ub * w, const _ub * b, size_t n);
+bool pbbDivideInv         (_ub * q, _ub * r, const _ub * a, size_t la, const PBBINVN * pi);
+_ub  pbbMontgomeryInvert1 (_ub m);
+void pbbMontgomeryMultiply(_ub * c, const _ub * a, const _ub * b, const _ub * m, size_t n, _ub k, _ub * t);
+void pbbMontgomeryReduce  (_ub * c, _ub * t, const _ub * m, size_t n, _ub k);
+
+#endif
+
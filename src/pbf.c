@@ -3,24 +3,37 @@
  * Description: Portable big integer FFT multiplication support.
  * Author:	    cosh.cage#hotmail.com
  *              This file is partially generated by Copilot AI.
- * File ID:	    0917252155B1102250131L00200
+ * File ID:	    0917252155B1019261030L00520
  * License:	    GPLv3.
  * Caution:     Link this file with -lm parameter on gcc.
  *
  * Note: This file provides an FFT-based multiplication for big integers in binary format using the BINT structure.
  *	   This implementation uses iterative FFT (Cooley-Tukey) and double precision (not cryptographically secure).
+ *	   Blocks are split into digits of at most 16 bits so that every convolution term stays exact in a double.
+ *	   An operand can be transformed once into a TBINT and then multiplied by many big integers.
  */
-#include <stdlib.h> /* Use function calloc, free. */
+#include <stdlib.h> /* Use function malloc, calloc, free. */
+#include <string.h> /* Use function memcpy, memset. */
 #include <math.h>   /* Use function sin, cos. */
-#include "pbk.h"
+#include "pbb.h"
 
 /* Define double constant PI. */
 #ifndef M_PI
 #define M_PI 3.14159265358979323846264338327950288419716939937511
 #endif
 
+#define PBF_MAX_BITS 16U /* Maximum bits of a transform digit. */
+#define PBF_MIN_BITS 4U  /* Minimum bits of a transform digit. */
+
 /* File scope function declaration. */
-static void _pbfFFTTransform(double * real, double * imag, size_t n, bool binv);
+static void   _pbfFFTTransform(double * real, double * imag, const double * wr, const double * wi, size_t n, bool binv);
+static void   _pbfTwiddle     (double * wr, double * wi, size_t n);
+static size_t _pbfPlan        (_ub * pbits, size_t len_a, size_t len_b);
+static size_t _pbfDigits      (size_t len, _ub bits);
+static void   _pbfSplit       (double * real, const _ub * data, size_t len, _ub bits);
+static void   _pbfPointwise   (double * ar, double * ai, const double * br, const double * bi, size_t n);
+static void   _pbfCompose     (_ub * c, const double * real, size_t cnt, _ub bits, size_t len);
+static void   _pbfSetFlag     (P_BINT c, size_t len, _ib sign);
 
 /* Attention:     This Is An Internal Function. No Interface for Library Users.
  * Function name: _pbfFFTTransform
@@ -28,60 +41,51 @@ static void _pbfFFTTransform(double * real, double * imag, size_t n, bool binv);
  * Parameters:
  *       real Pointer to real part array.
  *       imag Pointer to image part array.
+ *         wr Pointer to the real part of twiddle factors.
+ *         wi Pointer to the image part of twiddle factors.
  *          n The length of complex array.
  *       binv true: Inverse transform. false: Forward transform.
  * Return value:  N/A.
  */
-static void _pbfFFTTransform(double * real, double * imag, size_t n, bool binv)
+static void _pbfFFTTransform(double * real, double * imag, const double * wr, const double * wi, size_t n, bool binv)
 {
 	register size_t i, j, len;
+
 	/* Bit reversal permutation. */
-	size_t bits = 0;
-	
-	for (len = n; len > 1; len >>= 1)
-		++bits;
-	
-	for (i = 0; i < n; ++i)
+	for (i = 1, j = 0; i < n; ++i)
 	{
-		register size_t rev = 0;
-		for (j = 0; j < bits; ++j)
-		{
-			if (i & (1 << j))
-				rev |= 1 << (bits - 1 - j);
-		}
-		if (rev > i)
+		register size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
 		{
 			register double tmp = real[i];
-			real[i] = real[rev];
-			real[rev] = tmp;
-			
+			real[i] = real[j];
+			real[j] = tmp;
+
 			tmp = imag[i];
-			imag[i] = imag[rev];
-			imag[rev] = tmp;
+			imag[i] = imag[j];
+			imag[j] = tmp;
 		}
 	}
 
 	for (len = 2; len <= n; len <<= 1)
 	{
-		register double ang = 2 * M_PI / len * (binv ? -1 : 1);
-		register double wlen_real = cos(ang), wlen_imag = sin(ang);
+		register size_t k = len >> 1, step = n / len;
 		for (i = 0; i < n; i += len)
 		{
-			register size_t k = len >> 1;
-			register double w_real = 1, w_imag = 0;
 			for (j = 0; j < k; ++j)
 			{
 				register size_t u = i + j, v = i + j + k;
+				register double w_real = wr[j * step];
+				register double w_imag = binv ? -wi[j * step] : wi[j * step];
 				register double r = real[v] * w_real - imag[v] * w_imag;
 				register double im = real[v] * w_imag + imag[v] * w_real;
-				register double next_w_real;
 				real[v] = real[u] - r;
 				imag[v] = imag[u] - im;
 				real[u] += r;
 				imag[u] += im;
-				next_w_real = w_real * wlen_real - w_imag * wlen_imag;
-				w_imag = w_real * wlen_imag + w_imag * wlen_real;
-				w_real = next_w_real;
 			}
 		}
 	}
@@ -95,6 +99,230 @@ static void _pbfFFTTransform(double * real, double * imag, size_t n, bool binv)
 	}
 }
 
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfTwiddle
+ * Description:   Fill the twiddle factor table of a transform.
+ * Parameters:
+ *         wr Pointer to the real part of twiddle factors. It holds n / 2 elements.
+ *         wi Pointer to the image part of twiddle factors. It holds n / 2 elements.
+ *          n The length of transform.
+ * Return value:  N/A.
+ * Tip:           Each factor is computed directly instead of by recurrence to keep rounding errors small.
+ */
+static void _pbfTwiddle(double * wr, double * wi, size_t n)
+{
+	register size_t i;
+	for (i = 0; i < (n >> 1); ++i)
+	{
+		register double ang = 2 * M_PI * (double)i / (double)n;
+		wr[i] = cos(ang);
+		wi[i] = sin(ang);
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfDigits
+ * Description:   Count transform digits of a block array.
+ * Parameters:
+ *        len Number of blocks.
+ *       bits Bits of each transform digit.
+ * Return value:  Number of transform digits.
+ */
+static size_t _pbfDigits(size_t len, _ub bits)
+{
+	return (len * UB_BIT + bits - 1) / bits;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfPlan
+ * Description:   Choose digit width and transform length for a product.
+ * Parameters:
+ *      pbits Pointer to a block integer to store the bits of each transform digit.
+ *      len_a Number of blocks of the first operand.
+ *      len_b Number of blocks of the second operand.
+ * Return value:  Transform length.
+ * Tip:           A convolution term is at most n * 2 ^ (2 * bits). Together with the error of
+ *                the transform this shall fit in 53 bits of a double, thus bits shrinks as n grows.
+ */
+static size_t _pbfPlan(_ub * pbits, size_t len_a, size_t len_b)
+{
+	register _ub bits, lg;
+	register size_t n;
+	for (bits = PBF_MAX_BITS; ; --bits)
+	{
+		register size_t cnt = _pbfDigits(len_a, bits) + _pbfDigits(len_b, bits) - 1;
+		for (n = 1, lg = 0; n < cnt; n <<= 1)
+			++lg;
+		if (4 * bits + 3 * lg <= 100 || PBF_MIN_BITS == bits)
+			break;
+	}
+	*pbits = bits;
+	return n;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfSplit
+ * Description:   Split a block array into transform digits.
+ * Parameters:
+ *       real Pointer to a zeroed double array.
+ *       data Pointer to block array.
+ *        len Number of blocks.
+ *       bits Bits of each transform digit.
+ * Return value:  N/A.
+ */
+static void _pbfSplit(double * real, const _ub * data, size_t len, _ub bits)
+{
+	register size_t i, j, cnt = _pbfDigits(len, bits);
+	register _udb acc = 0, mask = ((_udb)1 << bits) - 1;
+	register _ub nacc = 0;
+	for (i = j = 0; i < cnt; ++i)
+	{
+		if (nacc < bits && j < len)
+		{
+			acc |= (_udb)data[j++] << nacc;
+			nacc += UB_BIT;
+		}
+		real[i] = (double)(acc & mask);
+		acc >>= bits;
+		nacc = nacc >= bits ? nacc - bits : 0;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfPointwise
+ * Description:   Pointwise complex multiplication. a := a * b;
+ * Parameters:
+ *         ar Pointer to real part of a.
+ *         ai Pointer to image part of a.
+ *         br Pointer to real part of b.
+ *         bi Pointer to image part of b.
+ *          n The length of complex arrays.
+ * Return value:  N/A.
+ * Tip:           ar may equal to br and ai may equal to bi, it squares a.
+ */
+static void _pbfPointwise(double * ar, double * ai, const double * br, const double * bi, size_t n)
+{
+	register size_t i;
+	for (i = 0; i < n; ++i)
+	{
+		register double real = ar[i] * br[i] - ai[i] * bi[i];
+		register double imag = ar[i] * bi[i] + ai[i] * br[i];
+		ar[i] = real;
+		ai[i] = imag;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfCompose
+ * Description:   Round convolution terms and compose them into a block array.
+ * Parameters:
+ *          c Pointer to a block array to store the result.
+ *       real Pointer to convolution terms.
+ *        cnt Number of convolution terms.
+ *       bits Bits of each transform digit.
+ *        len Number of blocks of c.
+ * Return value:  N/A.
+ */
+static void _pbfCompose(_ub * c, const double * real, size_t cnt, _ub bits, size_t len)
+{
+	register size_t i, k = 0;
+	register _udb carry = 0, acc = 0, mask = ((_udb)1 << bits) - 1;
+	register _ub nacc = 0;
+
+	for (i = 0; i < cnt || carry; ++i)
+	{	/* Rounding for floating point error. */
+		if (i < cnt && real[i] >= 0.5)
+			carry += (_udb)(real[i] + 0.5);
+		acc |= (carry & mask) << nacc;
+		nacc += bits;
+		carry >>= bits;
+		if (nacc >= UB_BIT)
+		{
+			if (k < len)
+				c[k++] = (_ub)acc;
+			acc >>= UB_BIT;
+			nacc -= UB_BIT;
+		}
+	}
+	if (nacc && k < len)
+		c[k++] = (_ub)acc;
+	if (k < len)
+		memset(c + k, 0, (len - k) * sizeof(_ub));
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbfSetFlag
+ * Description:   Set the flag of a product.
+ * Parameters:
+ *          c Pointer to a big integer that holds the product.
+ *        len Number of blocks of the product.
+ *       sign Sign of the product.
+ * Return value:  N/A.
+ */
+static void _pbfSetFlag(P_BINT c, size_t len, _ib sign)
+{
+	SETFLAG(c, (_ib)len);
+	pbkShrinkZeroFlag(c);
+	if (!pbkIsBintEqualToZero(c))
+		SETFLAG(c, GETFLAG(c) * sign);
+}
+
+/* Function name: pbbMultiplyFFT
+ * Description:   Multiplies two block arrays using FFT.
+ * Parameters:
+ *          c Pointer to a block array of la + lb blocks to store the product.
+ *          a Pointer to a block array.
+ *         la Number of blocks of a. la > 0.
+ *          b Pointer to a block array.
+ *         lb Number of blocks of b. lb > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not overlap a or b.
+ * Tip:           c := a * b;
+ *                If a equals to b and la equals to lb, only one forward transform is taken.
+ */
+bool pbbMultiplyFFT(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	register bool bsqr = a == b && la == lb;
+	double * A, * B, * Ai, * Bi, * W;
+	size_t n;
+	_ub bits;
+
+	n = _pbfPlan(&bits, la, lb);
+
+	/* Allocate FFT arrays and twiddle factors. */
+	A = (double *)calloc((bsqr ? 3 : 5) * n, sizeof(double));
+
+	if (!A)
+		return false;
+
+	Ai = A + n;
+	B = bsqr ? A : Ai + n;
+	Bi = bsqr ? Ai : B + n;
+	W = Bi + n;
+
+	_pbfTwiddle(W, W + (n >> 1), n);
+
+	/* Copy integer blocks to double arrays and transform. */
+	_pbfSplit(A, a, la, bits);
+	_pbfFFTTransform(A, Ai, W, W + (n >> 1), n, false);
+	if (!bsqr)
+	{
+		_pbfSplit(B, b, lb, bits);
+		_pbfFFTTransform(B, Bi, W, W + (n >> 1), n, false);
+	}
+
+	_pbfPointwise(A, Ai, B, Bi, n);
+
+	/* Inverse FFT. */
+	_pbfFFTTransform(A, Ai, W, W + (n >> 1), n, true);
+
+	_pbfCompose(c, A, _pbfDigits(la, bits) + _pbfDigits(lb, bits) - 1, bits, la + lb);
+
+	free(A);
+	return true;
+}
+
 /*
  * Function name: pbkMultiplyBintFFT
  * Description:   Multiplies two big integers using FFT and stores result to c.
@@ -106,6 +334,7 @@ static void _pbfFFTTransform(double * real, double * imag, size_t n, bool binv)
  *               false: Failed.
  * Caution:      The address of c shall not equal to a or b.
  * Tip:          c := a * b;
+ *               If a and b are the same big integer, only one forward transform is taken.
  */
 bool pbkMultiplyBintFFT(P_BINT c, P_BINT a, P_BINT b)
 {
@@ -113,88 +342,179 @@ bool pbkMultiplyBintFFT(P_BINT c, P_BINT a, P_BINT b)
 		return false;
 	else
 	{
-		register _udb carry;
-		register size_t clen;
-		register size_t i;
 		_ib sign_a = GETFLAG(a) >= 0 ? 1 : -1;
 		_ib sign_b = GETFLAG(b) >= 0 ? 1 : -1;
 		register size_t len_a = GETABS(GETFLAG(a));
 		register size_t len_b = GETABS(GETFLAG(b));
-		double * A, * B, * Ai, * Bi;
-		size_t n;
-		
-		if (len_a == 0 || len_b == 0)
+
+		if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b))
 			return pbkIbToBint(c, 0);
 
-		/* Find the smallest power of two >= len_a + len_b. */
-		n = 1;
-		while (n < len_a + len_b)
-			n <<= 1;
+		if (!pbkReallocBint(c, (_ub)(len_a + len_b), true))
+			return false;
 
-		/* Allocate FFT arrays. */
-		A = (double *)calloc(4 * n, sizeof(double));
-		
-		if (!A)
+		if (!pbbMultiplyFFT(c->data, a->data, len_a, b->data, len_b))
 			return false;
-		
-		B = A + n;
-		Ai = B + n;
-		Bi = Ai + n;
-
-		/* Copy integer blocks to double arrays. */
-		for (i = 0; i < len_a; ++i)
-			A[i] = (double)a->data[i];
-		for (i = 0; i < len_b; ++i)
-			B[i] = (double)b->data[i];
-
-		/* Forward FFT. */
-		_pbfFFTTransform(A, Ai, n, false);
-		_pbfFFTTransform(B, Bi, n, false);
-
-		/* Pointwise multiplication. */
-		for (i = 0; i < n; ++i)
+
+		_pbfSetFlag(c, len_a + len_b, sign_a * sign_b);
+		return true;
+	}
+}
+
+/* Function name: pbkInitTbint
+ * Description:   Transform a big integer for repeated FFT multiplication.
+ * Parameters:
+ *         pt Pointer to a transformed big integer.
+ *          a Pointer to a big integer to transform.
+ *     blocks Maximum number of blocks of big integers that will be multiplied by pt.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Transformed big integer structure shall be initialized to 0.
+ * Tip:           Pass GETABS(GETFLAG(a)) to blocks to square pt by pbkSquareTbint.
+ */
+bool pbkInitTbint(P_TBINT pt, P_BINT a, _ub blocks)
+{
+	if (NULL == pt->data && !pbkIsNotANumber(a))
+	{
+		register size_t n, len = GETABS(GETFLAG(a));
+		_ub bits;
+
+		n = _pbfPlan(&bits, len, blocks ? blocks : 1);
+
+		pt->data = (double *)calloc(3 * n, sizeof(double));
+		if (NULL != pt->data)
 		{
-			register double real = A[i] * B[i] - Ai[i] * Bi[i];
-			register double imag = A[i] * Bi[i] + Ai[i] * B[i];
-			A[i] = real;
-			Ai[i] = imag;
+			SETFLAG(pt, GETFLAG(a));
+			SETSIZE(pt, n);
+			pt->bits = bits;
+
+			_pbfTwiddle(pt->data + 2 * n, pt->data + 2 * n + (n >> 1), n);
+			if (!pbkIsBintEqualToZero(a))
+			{
+				_pbfSplit(pt->data, a->data, len, bits);
+				_pbfFFTTransform(pt->data, pt->data + n, pt->data + 2 * n, pt->data + 2 * n + (n >> 1), n, false);
+			}
+			return true;
 		}
+	}
+	return false;
+}
 
-		/* Inverse FFT. */
-		_pbfFFTTransform(A, Ai, n, true);
+/* Function name: pbkFreeTbint
+ * Description:   Deallocate a transformed big integer.
+ * Parameter:
+ *        pt Pointer to a transformed big integer.
+ * Return value:  N/A.
+ */
+void pbkFreeTbint(P_TBINT pt)
+{
+	if (pt->data)
+		free(pt->data);
+	pt->data = NULL;
+	SETFLAG(pt, 0);
+	SETSIZE(pt, 0U);
+}
 
-		/* Prepare result. */
-		if (!pbkReallocBint(c, n, true))
+/* Function name: pbkMultiplyTbint
+ * Description:   Multiplies a transformed big integer by a big integer and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a transformed big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed. Or b is longer than the blocks a was transformed for.
+ * Caution:       The address of c shall not equal to b.
+ * Tip:           c := a * b;
+ *                Only b is transformed, a keeps its spectrum for the next invoking.
+ */
+bool pbkMultiplyTbint(P_BINT c, P_TBINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	else
+	{
+		register size_t n = GETSIZE(a);
+		register size_t len_a = GETABS(GETFLAG(a));
+		register size_t len_b = GETABS(GETFLAG(b));
+		register size_t cnt = _pbfDigits(len_a, a->bits) + _pbfDigits(len_b, a->bits) - 1;
+		double * B, * W = a->data + 2 * n;
+		bool r;
+
+		if (cnt > n)
 			return false;
 
-		carry = 0;
-		for (i = 0; i < n; ++i)
-		{	/* Rounding for floating point error. */
-			register _udb val = (_udb)(A[i] + 0.5) + carry;
-			c->data[i] = (_ub)(val & UBLOCK_FULL);
-			carry = val >> UB_BIT;
-		}
+		if (pbkIsBintEqualToZero(b))
+			return pbkIbToBint(c, 0);
+
+		B = (double *)calloc(2 * n, sizeof(double));
+
+		if (!B)
+			return false;
+
+		_pbfSplit(B, b->data, len_b, a->bits);
+		_pbfFFTTransform(B, B + n, W, W + (n >> 1), n, false);
+		_pbfPointwise(B, B + n, a->data, a->data + n, n);
+		_pbfFFTTransform(B, B + n, W, W + (n >> 1), n, true);
 
-		/* Handle remaining carry. */
-		clen = n;
-		while (carry)
+		if (pbkReallocBint(c, (_ub)(len_a + len_b), true))
 		{
-			if (clen >= GETSIZE(c))
-			{
-				if (!pbkReallocBint(c, clen + 1, true))
-					break;
-			}
-			c->data[clen++] = (_ub)(carry & UBLOCK_FULL);
-			carry >>= UB_BIT;
+			_pbfCompose(c->data, B, cnt, a->bits, len_a + len_b);
+			_pbfSetFlag(c, len_a + len_b, GETSGN(GETFLAG(a)) * (GETFLAG(b) >= 0 ? 1 : -1));
+			r = true;
 		}
+		else
+			r = false;
 
-		/* Remove leading zeros. */
-		while (clen > 1 && 0 == c->data[clen - 1])
-			--clen;
-		SETFLAG(c, (_ib)clen * sign_a * sign_b);
+		free(B);
+		return r;
+	}
+}
 
-		free(A);
+/* Function name: pbkSquareTbint
+ * Description:   Squares a transformed big integer and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a transformed big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed. Or a was not transformed for its own length.
+ * Tip:           c := a * a;
+ *                No forward transform is taken.
+ */
+bool pbkSquareTbint(P_BINT c, P_TBINT a)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	else
+	{
+		register size_t n = GETSIZE(a);
+		register size_t len = GETABS(GETFLAG(a));
+		register size_t cnt = 2 * _pbfDigits(len, a->bits) - 1;
+		double * B, * W = a->data + 2 * n;
+		bool r;
+
+		if (cnt > n)
+			return false;
+
+		B = (double *)malloc(2 * n * sizeof(double));
+
+		if (!B)
+			return false;
+
+		memcpy(B, a->data, 2 * n * sizeof(double));
+		_pbfPointwise(B, B + n, B, B + n, n);
+		_pbfFFTTransform(B, B + n, W, W + (n >> 1), n, true);
+
+		if (pbkReallocBint(c, (_ub)(2 * len), true))
+		{
+			_pbfCompose(c->data, B, cnt, a->bits, 2 * len);
+			_pbfSetFlag(c, 2 * len, 1);
+			r = true;
+		}
+		else
+			r = false;
+
+		free(B);
+		return r;
 	}
-	return true;
 }
 
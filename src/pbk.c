@@ -1,1604 +1,3919 @@
-﻿/*
- * Name:        pbk.c
- * Description: Portable big integer library kernel.
- * Author:      cosh.cage#hotmail.com
- * File ID:     0520240323B1101251046L01605
- * License:     GPLv3.
- */
-
-#include "pbk.h"
-#include <stdio.h>  /* Using function putchar, printf. */
-#include <stdlib.h> /* Using function memcpy, memmove, malloc, realloc. */
-#include <string.h> /* Using function memset, strlen. */
-
-/* File level function declarations. */
-static _ubdiv_t _ubdiv(_ub numerator, _ub denominator);
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _ubdiv
- * Description:   Compute a quotient that truncates toward 0 and the corresponding remainder.
- * Parameters:
- *  numerator Numerator.
- *denominator Denominator.
- * Return value:  A _ubdiv_t structure which contains the result.
- */
-static _ubdiv_t _ubdiv(_ub numerator, _ub denominator)
-{
-	_ubdiv_t result;
-	/* Just give me some optimization. */
-	result.quot = numerator / denominator;
-	result.rem  = numerator % denominator;
-	return result;
-}
-
-/* Function name: pbkInitBint
- * Description:   Initialize a big integer.
- * Parameters:
- *        pbi Pointer to a big integer.
- *          i Initial value you want to set to big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Big integer structure shall be initialized to 0.
- * Tip:           This function is used only to initialize big integers,
- *                but not for change the value or capacity for any big integer.
- */
-bool pbkInitBint(P_BINT pbi, _ib i)
-{
-	if (NULL == pbi->data)
-	{
-		SETFLAG(pbi, (i == 0 ? 1 : GETSGN(i)));
-		SETSIZE(pbi, BINT_INIT_SIZE);
-		SETINCL(pbi, BINT_INIT_INCL);
-		pbi->data = (_ub *)malloc(sizeof(_ub) * (GETSIZE(pbi) + GETINCL(pbi)));
-		if (NULL != pbi->data)
-		{
-			pbi->data[0] = GETABS(i);
-			return true;
-		}
-		else
-		{
-			SETFLAG(pbi, 0);
-			SETSIZE(pbi, 0U);
-		}
-	}
-	return false;
-}
-
-/* Function name: pbkReallocBint
- * Description:   Reallocate a big integer.
- * Parameters:
- *        pbi Pointer to a big integer.
- *       size New size of capacity to big integer.
- *       binc Increase the capacity or decrease it.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function can be used to initialize big integers.
- */
-bool pbkReallocBint(P_BINT pbi, _ub size, bool binc)
-{
-	if (!binc && (GETSIZE(pbi) == size))
-	{
-		return true;
-	}
-	else if (binc && (GETSIZE(pbi) >= size))
-	{
-		return true;
-	}
-	else
-	{
-		_ub * pnew = (_ub *)realloc(pbi->data, SETSIZE(pbi, (binc ? size + GETINCL(pbi) : size)) * sizeof(_ub));
-		if (NULL != pnew)
-		{
-			pbi->data = pnew;
-			return true;
-		}
-		else
-		{
-			SETFLAG(pbi, 0);
-			SETSIZE(pbi, 0U);
-			pbi->data = NULL;
-			return false;
-		}
-	}
-}
-
-/* Function name: pbkFreeBint
- * Description:   Initialize a big integer.
- * Parameter:
- *       pbi Pointer to a big integer.
- * Return value:  N/A.
- */
-void pbkFreeBint(P_BINT pbi)
-{
-	if (pbi->data)
-		free(pbi->data);
-	pbi->data = NULL;
-	SETFLAG(pbi, 0);
-	SETSIZE(pbi, 0U);
-}
-
-/* Function name: pbkCreateBint
- * Description:   Create a big integer in main memory.
- * Parameter:
- *         i Initial value you want to set to big integer.
- * Return value:  Pointer to new created big integer structure.
- */
-P_BINT pbkCreateBint(_ib i)
-{
-	register P_BINT pbi = malloc(sizeof(BINT));
-	if (NULL != pbi)
-	{
-		memset(pbi, 0, sizeof(BINT));
-		if (!pbkInitBint(pbi, i))
-		{
-			free(pbi);
-			pbi = NULL;
-		}
-	}
-	return pbi;
-}
-
-/* Function name: pbkDeleteBint
- * Description:   Deallocate a big integer from main memory.
- * Parameter:
- *       pbi Pointer to a big integer.
- * Return value:  N/A.
- */
-void pbkDeleteBint(P_BINT pbi)
-{
-	pbkFreeBint(pbi);
-	free(pbi);
-}
-
-/* Function name: pbkMoveBint
- * Description:   Move the memory of a big integer to another big integer.
- * Parameters:
- *          a Pointer to a big integer.
- *          b Pointer to another big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Parameter a and b shall not be NULL.
- * Tip:           After invoking, the capacity of a will equal to b's. 
- */
-bool pbkMoveBint(P_BINT a, P_BINT b)
-{
-	if (pbkReallocBint(a, GETSIZE(b), true))
-	{
-		memmove(a->data, b->data, GETABS(GETFLAG(b)) * sizeof(_ub));
-		SETFLAG(a, GETFLAG(b));
-		return true;
-	}
-	return false;
-}
-
-/* Function name: pbkCopyBint
- * Description:   Copy a big integer.
- * Parameter:
- *         a Pointer to a big integer.
- * Return value:  Pointer to the copy of big integer a.
- */
-P_BINT pbkCopyBint(P_BINT a)
-{
-	register P_BINT pbi = pbkCreateBint(0);
-	if (NULL != pbi)
-	{
-		if (pbkMoveBint(pbi, a))
-			return pbi;
-		pbkFreeBint(pbi);
-		pbi = NULL;
-	}
-	return pbi;
-}
-
-/* Function name: pbkIbToBint
- * Description:   Convert an integer to big integer.
- * Parameters:
- *          a Pointer to a big integer.
- *          i Value you want to set to the big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function will not change a's capacity.
- */
-bool pbkIbToBint(P_BINT a, _ib i)
-{
-	if (pbkIsNotANumber(a))
-		return false;
-	a->data[0] = GETABS(i);
-	SETFLAG(a, 0 == GETSGN(i) ? 1 : GETSGN(i));
-	return true;
-}
-
-/* Function name: pbkBintToIb
- * Description:   Convert a big integer to signed block integer.
- * Parameter:
- *         a Pointer to a big integer.
- * Return value:  Converted signed block integer.
- *                If this function fails to convert, it would return 0.
- * Caution:       Only the latest block of big integer can be converted.
- */
-_ib pbkBintToIb(P_BINT a)
-{
-	if (pbkIsNotANumber(a))
-		return 0;
-	return GETFLAG(a) >= 0 ? (_ib)*a->data : -(_ib)*a->data;
-}
-
-/* Function name: pbkCompareBint
- * Description:   Compare two big integers.
- * Parameters:
- *          a Pointer to a big integer.
- *          b Pointer to another big integer.
- * Return value:  0:  a == b. Or can not compare.
- *                1:  a > b.
- *                -1: a < b.
- * Caution:       If a or b is NaN, function will return 0.
- */
-int pbkCompareBint(P_BINT a, P_BINT b)
-{
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-		return 0; /* Can not compare. */
-	else
-	{
-		if (GETFLAG(a) == GETFLAG(b) && a->data == b->data)
-			return 0;
-		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 . +1. */
-		{
-			if (GETFLAG(a) > GETFLAG(b))
-			{
-				return 1;
-			}
-			else if (GETFLAG(a) < GETFLAG(b))
-			{
-				return -1;
-			}
-			else
-			{
-				_ub f = 1;
-				if (*(char *)&f)
-				{	/* Little endian. */
-					register size_t i, j;
-					register _udb x, y;
-					if (0 == (GETFLAG(a) & 0x1)) /* 0 == GETFLAG(a) % 2; */
-					{
-						for (i = GETFLAG(a); i > 0; i -= 2)
-						{
-							j = i - 2;
-							x = *(_udb *)&j[a->data];
-							y = *(_udb *)&j[b->data];
-							if (x > y)
-								return 1;
-							else if (x < y)
-								return -1;
-						}
-					}
-					else
-					{
-						if (GETFLAG(a) > 2)
-						{
-							for (i = GETFLAG(a); i > 1; i -= 2)
-							{
-								j = i - 2;
-								x = *(_udb *)&j[a->data];
-								y = *(_udb *)&j[b->data];
-								if (x > y)
-									return 1;
-								else if (x < y)
-									return -1;
-							}
-						}
-						x = 0[a->data];
-						y = 0[b->data];
-						if (x > y)
-							return 1;
-						else if (x < y)
-							return -1;
-					}
-					return 0;
-				}
-				else /* Big endian. */
-				{
-					register size_t i, j;
-					register _ub x, y;
-					for (i = GETFLAG(a); i > 0; --i)
-					{
-						j = i - 1;
-						x = j[a->data];
-						y = j[b->data];
-						if (x > y)
-							return 1;
-						else if (x < y)
-							return -1;
-					}
-					return 0;
-				}
-			}
-		}
-		else if (GETFLAG(a) < 0 && GETFLAG(b) > 0) /* -1 . +1. */
-		{
-			return -1;
-		}
-		else if (GETFLAG(a) > 0 && GETFLAG(b) < 0) /* +1 . -1. */
-		{
-			return 1;
-		}
-		else /* -1 . -1. */
-		{
-			register int r;
-			register _ib fa, fb;
-
-			fa = GETFLAG(a);
-			fb = GETFLAG(b);
-
-			SETFLAG(a, GETABS(GETFLAG(a)));
-			SETFLAG(b, GETABS(GETFLAG(b)));
-
-			r = -pbkCompareBint(a, b);
-
-			SETFLAG(a, fa);
-			SETFLAG(b, fb);
-
-			return r;
-		}
-	}
-}
-
-/* Function name: pbkAddBint
- * Description:   Adds two big integers and stores result to c.
- * Parameters:
- *          c Pointer to a big integer.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       The address of c shall not equal to a or b.
- * Tip:           c := a + b;
- */
-bool pbkAddBint(P_BINT c, P_BINT a, P_BINT b)
-{
-	if (pbkReallocBint(c, GETSIZE(a) > GETSIZE(b) ? GETSIZE(a) : GETSIZE(b), true))
-	{
-		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 + +1. */
-		{
-			register size_t i, j = GETMIN(GETFLAG(a), GETFLAG(b)), k = GETMAX(GETFLAG(a), GETFLAG(b));
-			register _udb r = 0;
-			P_BINT pir = GETFLAG(a) > GETFLAG(b) ? a : b;
-
-			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-				return false;
-
-			if (a == b && a->data == b->data) /* a + a = 2 * a. */
-			{
-				if (c->data != a->data)
-					pbkMoveBint(c, a);
-
-				if (!pbkLeftShiftBint(c, 0, 1))
-					return false;
-
-				return true;
-			}
-
-			for (i = 0; i < j; ++i)
-			{
-				r = CARRY(r) + (_udb)a->data[i] + (_udb)b->data[i];
-				c->data[i] = (_ub)r;
-			}
-			for (; i < k; ++i)
-			{
-				r = CARRY(r) + (_udb)pir->data[i];
-				c->data[i] = (_ub)r;
-			}
-
-			if (GETFLAG(c) + 1 >= (_ib)GETSIZE(c))
-			{
-				if (!pbkReallocBint(c, GETSIZE(c), true))
-					return false;
-			}
-			c->data[i] = (_ub)CARRY(r);
-			SETFLAG(c, (_ib)i + 1);
-			pbkShrinkZeroFlag(c);
-			return true;
-		}
-		else if (GETFLAG(a) < 0 && GETFLAG(b) > 0) /* -1 + +1. */
-		{
-			register int r;
-			register _ib fa;
-
-			fa = GETFLAG(a);
-
-			SETFLAG(a, -GETFLAG(a));
-
-			r = pbkSubtractBint(c, b, a);
-
-			SETFLAG(a, fa);
-
-			return r;
-		}
-		else if (GETFLAG(a) > 0 && GETFLAG(b) < 0) /* +1 + -1. */
-		{
-			return pbkSubtractBint(c, a, b);;
-		}
-		else /* -1 + -1. */
-		{
-			register int r;
-			register _ib fa, fb;
-
-			fa = GETFLAG(a);
-			fb = GETFLAG(b);
-
-			SETFLAG(a, GETABS(GETFLAG(a)));
-			SETFLAG(b, GETABS(GETFLAG(b)));
-
-			r = pbkAddBint(c, a, b);
-
-			SETFLAG(a, fa);
-			SETFLAG(b, fb);
-
-			if (r)
-				SETFLAG(c, -GETFLAG(c));
-
-			return r;
-		}
-	}
-	return false;
-}
-
-/* Function name: pbkSubtractBint
- * Description:   Subtracts two big integers and stores result to c.
- * Parameters:
- *          c Pointer to a big integer.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       The address of c shall not equal to a or b.
- * Tip:           c := a - b;
- */
-bool pbkSubtractBint(P_BINT c, P_BINT a, P_BINT b)
-{
-	if (pbkReallocBint(c, GETSIZE(a) > GETSIZE(b) ? GETSIZE(a) : GETSIZE(b), false))
-	{
-		if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-			return false;
-		else if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 - +1. */
-		{
-			if (pbkCompareBint(a, b) >= 0)
-			{
-				register size_t i, j = GETMIN(GETFLAG(a), GETFLAG(b)), k = GETMAX(GETFLAG(a), GETFLAG(b));
-				register _ub x, y;
-				register bool borrow = false;
-
-				if (a == b && a->data == b->data) /* a - a = 0. */
-				{
-					pbkFreeBint(c);
-
-					if (!pbkInitBint(c, 0))
-						return false;
-
-					return true;
-				}
-				
-				for (i = 0; i < j; ++i)
-				{
-					y = a->data[i];
-
-					if (borrow)
-					{
-						x = y - 1;
-					}
-					else
-					{
-						x = y;
-					}
-
-					y = b->data[i];
-					c->data[i] = x - y;
-
-					if (x < y)
-					{
-						borrow = true;
-					}
-					else
-					{
-						borrow = false;
-					}
-				}
-				for (; i < k; ++i)
-				{
-					y = a->data[i];
-
-					if (borrow)
-					{
-						x = y - 1;
-					}
-					else
-					{
-						x = y;
-					}
-
-					c->data[i] = x;
-
-					if (0 == y)
-						borrow = true;
-					else
-						borrow = false;
-				}
-				SETFLAG(c, (_ib)i);
-				pbkShrinkZeroFlag(c);
-				if (GETFLAG(c) < (_ib)(GETSIZE(c) - GETINCL(c)))
-				{
-					if (!pbkReallocBint(c, GETSIZE(c) - GETINCL(c), false))
-						return false;
-				}
-				return true;
-			}
-			else /* +1 - +10. */
-			{
-				register bool r;
-
-				r = pbkSubtractBint(c, b, a);
-
-				if (r)
-					SETFLAG(c, -GETFLAG(c));
-
-				return r;
-			}
-
-		}
-		else
-		{
-			register int r;
-			register _ib fb;
-
-			fb = GETFLAG(b);
-
-			SETFLAG(b, -GETFLAG(b));
-
-			r = pbkAddBint(c, a, b);
-
-			SETFLAG(b, fb);
-
-			return r;
-		}
-	}
-	return false;
-}
-
-/* Function name: pbkLeftShiftBint
- * Description:   Left shift a big integer.
- * Parameters:
- *          c Pointer to a big integer.
- *     blocks Blocks of integer you want to shift.
- *       bits Bits of integer you want to shift.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool pbkLeftShiftBint(P_BINT a, _ub blocks, _ub bits)
-{
-	if (pbkIsNotANumber(a))
-		return false;
-	else
-	{
-		register _ubdiv_t u = _ubdiv(bits, UB_BIT);
-		register size_t i, j;
-		register _udb n = 0;
-
-		blocks += u.quot;
-
-		/* Handle blocks first. */
-		if (GETFLAG(a) + blocks + (u.rem ? 1 : 0) >= GETSIZE(a))
-		{
-			if (!pbkReallocBint(a, GETSIZE(a) + blocks + (u.rem ? 1 : 0), true))
-				return false;
-		}
-		if (blocks)
-		{
-			memmove(a->data + blocks, a->data, GETABS(GETFLAG(a)) * sizeof(_ub));
-			memset(a->data, 0, sizeof(_ub) * blocks);
-			SETFLAG(a, (GETFLAG(a) >= 0 ? GETFLAG(a) + blocks : -(_ib)(GETABS(GETFLAG(a)) + blocks)));
-		}
-
-		/* Handle bits next. */
-		if (u.rem)
-		{
-			j = GETABS(GETFLAG(a));
-			a->data[j] = 0;
-			for (i = j; i > 0; --i)
-			{
-				n = (_udb)a->data[i - 1] << u.rem;
-				a->data[i - 1] = (_ub)n;
-				a->data[i] |= CARRY(n);
-			}
-			SETFLAG(a, (GETFLAG(a) >= 0 ? GETFLAG(a) + 1 : -(_ib)(GETABS(GETFLAG(a)) + 1)));
-			pbkShrinkZeroFlag(a);
-		}
-
-		return true;
-	}
-}
-
-/* Function name: pbkRightShiftBint
- * Description:   Right shift a big integer.
- * Parameters:
- *          a Pointer to a big integer.
- *     blocks Blocks of integer you want to shift.
- *       bits Bits of integer you want to shift.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool pbkRightShiftBint(P_BINT a, _ub blocks, _ub bits)
-{
-	if (pbkIsNotANumber(a))
-		return false;
-	else
-	{
-		register _ubdiv_t u = _ubdiv(bits, UB_BIT);
-		register _ub n, n2;
-		register size_t i;
-
-		/* Handle blocks first. */
-		if (blocks)
-		{
-			register _ib b = GETABS(GETFLAG(a)) - blocks;
-			memmove(a->data, a->data + blocks, ((_ib)b >= 0 ? (_ub)b : GETABS(GETFLAG(a))) * sizeof(_ub));
-			b = b > 0 ? b : 1;
-			SETFLAG(a, (GETFLAG(a) >= 0 ? b : -b));
-		}
-
-		if (GETFLAG(a) - (u.rem ? 1 : 0) - blocks < (_ib)(GETSIZE(a) - GETINCL(a)))
-		{
-			if (!pbkReallocBint(a, GETSIZE(a) - GETINCL(a), false))
-				return false;
-		}
-
-		/* Handle bits next. */
-		if (u.rem)
-		{
-			for (n2 = n = 0, i = GETABS(GETFLAG(a)); i > 0; --i)
-			{
-				n = a->data[i - 1] << (UB_BIT - u.rem);
-				a->data[i - 1] >>= u.rem;
-				a->data[i - 1] |= n2;
-				n2 = n;
-				
-			}
-			pbkShrinkZeroFlag(a);
-		}
-
-		return true;
-	}
-}
-
-/* Function name: pbkMultiplyBintOld
- * Description:   Multiplies two big integers and stores result to c.
- * Parameters:
- *          c Pointer to a big integer.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       The address of c shall not equal to a or b.
- * Tip:           c := a * b;
- */
-bool pbkMultiplyBintOld(P_BINT c, P_BINT a, P_BINT b)
-{
-	if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 * +1. */
-	{
-		if (GETFLAG(a) > GETFLAG(b))
-		{
-			return pbkMultiplyBint(c, b, a);
-		}
-		else /* GETFLAG(a) <= GETFLAG(b). */
-		{
-			register size_t i, j, k = GETFLAG(a), l = 0, m = 0;
-			register _ub n;
-			BINT B = { 0 }, C = { 0 };
-			bool r = true;
-
-			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-				return false;
-
-			SETFLAG(c, 1);
-			c->data[0] = 0;
-
-			if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
-				return true;
-
-			if (!pbkMoveBint(&B, b))
-			{
-				r = false;
-				goto Lbl_Clear;
-			}
-			
-			for (i = 0; i < k; ++i)
-			{
-				n = a->data[i];
-
-				if (n)
-				{
-					for (j = 0; j < UB_BIT; ++j)
-					{
-						if (((_ub)1 << j) & n)
-						{
-							if (!pbkLeftShiftBint(&B, (_ub)m, (_ub)l))
-							{
-								r = false;
-								goto Lbl_Clear;
-							}
-							if (!pbkMoveBint(&C, c))
-							{
-								r = false;
-								goto Lbl_Clear;
-							}
-							if (!pbkAddBint(c, &B, &C))
-							{
-								r = false;
-								goto Lbl_Clear;
-							}
-							l = 1;
-							m = 0;
-						}
-						else
-						{
-							++l;
-						}
-					}
-				}
-				else
-				{
-					++m;
-				}
-			}
-		Lbl_Clear:
-			pbkFreeBint(&B);
-			pbkFreeBint(&C);
-			return r;
-		}
-	}
-	else
-	{
-		register int r;
-		register _ib fa, fb;
-
-		fa = GETFLAG(a);
-		fb = GETFLAG(b);
-
-		SETFLAG(a, GETABS(GETFLAG(a)));
-		SETFLAG(b, GETABS(GETFLAG(b)));
-
-		r = pbkMultiplyBint(c, a, b);
-
-		SETFLAG(a, fa);
-		SETFLAG(b, fb);
-
-		if (r)
-		{
-			if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
-				SETFLAG(c, -GETFLAG(c));
-		}
-
-		return r;
-	}
-}
-
-/* Function name: pbkMultiplyBintNew
- * Description:   Multiplies two big integers and stores result to c.
- * Parameters:
- *          c Pointer to a big integer.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       The address of c shall not equal to a or b.
- * Tip:           c := a * b;
- */
-bool pbkMultiplyBintNew(P_BINT c, P_BINT a, P_BINT b)
-{
-	if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 * +1. */
-	{
-		if (GETABS(GETFLAG(a)) <= GETABS(GETFLAG(b)))
-		{
-			register size_t i, j, k = GETFLAG(a), l = GETFLAG(b), m;
-			register _udb carry;
-			register _ub  t;
-			BINT A = { 0 };
-			bool r = true;
-
-			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-				return false;
-
-			SETFLAG(c, 1);
-			c->data[0] = 0;
-
-			if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
-				return true;
-
-			if (!pbkReallocBint(&A, k + l + 1, true))
-			{
-				r = false;
-				goto Lbl_Clear;
-			}
-
-			for (i = 0; i < k; ++i)
-			{
-				SETFLAG(&A, 1);
-				A.data[0] = 0;
-				carry = 0;
-				for (j = 0, m = l; j < l; ++j)
-				{
-					A.data[j] = CARRY(carry);
-					carry = (_udb)a->data[i] * (_udb)b->data[j] + (_udb)A.data[j];
-					A.data[j] = (_ub)carry;
-				}
-				t = CARRY(carry);
-				if (t)
-				{
-					A.data[j] = t;
-					++m;
-				}
-
-				SETFLAG(&A, (_ib)m);
-
-				if (!pbkLeftShiftBint(&A, i, 0))
-				{
-					r = false;
-					goto Lbl_Clear;
-				}
-				if (!pbkAddBint(c, c, &A))
-				{
-					r = false;
-					goto Lbl_Clear;
-				}
-			}
-		Lbl_Clear:
-			pbkFreeBint(&A);
-			return r;
-		}
-		else
-			return pbkMultiplyBintNew(c, b, a);
-	}
-	else
-	{
-		register int r;
-		register _ib fa, fb;
-
-		fa = GETFLAG(a);
-		fb = GETFLAG(b);
-
-		SETFLAG(a, GETABS(GETFLAG(a)));
-		SETFLAG(b, GETABS(GETFLAG(b)));
-
-		r = pbkMultiplyBint(c, a, b);
-
-		SETFLAG(a, fa);
-		SETFLAG(b, fb);
-
-		if (r)
-		{
-			if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
-				SETFLAG(c, -GETFLAG(c));
-		}
-
-		return r;
-	}
-}
-
-/* Function name: pbkDivideBint
- * Description:   Divides two big integers and stores quotient to q and stores reminder to r.
- * Parameters:
- *          q Pointer to a big integer that is the quotient. This value can be NULL.
- *          r Pointer to a big integer that is the reminder. This value can be NULL.
- *          a Pointer to a big integer that is the numerator.
- *          b Pointer to a big integer that is the denominator.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       The address of c shall not equal to a or b.
- * Tip:           q := a / b; r := a mod b;
- *                Parameter q or r can be NULL.
- */
-bool pbkDivideBint(P_BINT q, P_BINT r, P_BINT a, P_BINT b)
-{
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
-		return false;
-	else
-	{
-		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +10 / +1. */
-		{
-			if (pbkIsBintEqualToZero(b)) /* 1 / 0 = NaN. */
-				return false;
-
-			if (pbkIsBintEqualToZero(a)) /* 0 / 1 = 0...1 */
-			{
-				if (NULL != q)
-				{
-					SETFLAG(q, 1);
-					q->data[0] = 0;
-				}
-				if (NULL != r)
-					if (!pbkMoveBint(r, b))
-						return false;
-				return true;
-			}
-
-			if (pbkCompareBint(a, b) < 0)
-			{
-				if (NULL != r)
-					if (!pbkMoveBint(r, a))
-						return false;
-				if (NULL != q)
-					if (!pbkIbToBint(q, 0))
-						return false;
-				return true;
-			}
-			else
-			{
-				if ((NULL != r && pbkReallocBint(r, GETSIZE(a), false)) || (NULL != q && pbkReallocBint(q, GETSIZE(a), false)))
-				{
-					register _ub max, mid, min;
-					register ptrdiff_t i;
-					register _ub u;
-					register size_t j, k;
-					bool rtn = false;
-					/* Divisor and quotient. */
-					BINT D = { 0 }, Q = { 0 }, C = { 0 }, T = { 0 }, X = { 0 };
-
-					pbkInitBint(&D, 0);
-					pbkInitBint(&Q, 0);
-					pbkInitBint(&C, 0);
-					pbkInitBint(&T, 0);
-					pbkInitBint(&X, 0);
-
-					pbkMoveBint(&Q, a);
-					
-					if (NULL != q)
-						SETFLAG(q, 0);
-					
-					/* Put GETFLAG(b) blocks from a to Q. */
-					memcpy(Q.data, a->data + GETFLAG(a) - GETFLAG(b), GETFLAG(b) * sizeof(_ub));
-					SETFLAG(&Q, GETFLAG(b));
-
-					if (pbkCompareBint(b, &Q) > 0) /* b is bigger, enlarge Q. */
-					{
-						pbkLeftShiftBint(&Q, 1, 0);
-						memcpy(Q.data, a->data + GETFLAG(a) - GETFLAG(b) - 1, sizeof(_ub));
-						SETFLAG(&Q, GETFLAG(b) + 1);
-					}
-
-					if (!pbkMoveBint(&D, b))
-					{
-						rtn = false;
-						goto Lbl_Failure;
-					}
-
-					if (!pbkMoveBint(&C, &Q))
-					{
-						rtn = false;
-						goto Lbl_Failure;
-					}
-
-					/* Start dichotomization. */
-					max = UBLOCK_FULL;
-					min = 0;
-					mid = (_ub)((((_udb)max + min) >> 1) + 1);
-					i = GETFLAG(a) - GETFLAG(&Q);
-
-					for ( ;; )
-					{
-						T.data[0] = mid;
-						SETFLAG(&T, 1);
-
-						if (!pbkMultiplyBint(&X, &T, &D))
-						{
-							rtn = false;
-							goto Lbl_Failure;
-						}
-						
-						if (!pbkSubtractBint(&T, &Q, &X))
-						{
-							rtn = false;
-							goto Lbl_Failure;
-						}
-
-						if (GETFLAG(&T) <= 0)
-						{
-							max = mid;
-							mid = (_ub)(((_udb)max + min) >> 1);
-						}
-						else if (pbkCompareBint(&T, b) < 0)
-						{
-							/* Record the result as a part of answer. */
-							if (NULL != q)
-								q->data[GETFLAG(q)++] = mid;
-							for ( ;; )
-							{
-								if (--i < 0) /* Congratulations! */
-								{
-									if (NULL != r)
-									{
-										if (!pbkMoveBint(r, &T))
-										{
-											rtn = false;
-											goto Lbl_Failure;
-										}
-									}
-									rtn = true;
-									goto Lbl_Solved;
-								}
-
-								/* If reminder is not equal to zero, then left shit r for 1 section. */
-								if (!pbkLeftShiftBint(&T, 1, 0))
-								{
-									rtn = false;
-									goto Lbl_Failure;
-								}
-
-								T.data[0] = a->data[i];
-
-								if (pbkCompareBint(&T, b) < 0)
-								{
-									if (NULL != q)
-										q->data[GETFLAG(q)++] = 0;
-								}
-								else
-									break;
-							}
-							if (!pbkMoveBint(&C, &T))
-							{
-								rtn = false;
-								goto Lbl_Failure;
-							}
-							/* Reset dichotomization relative variables. */
-							max = UBLOCK_FULL;
-							min = 0x0;
-							mid = (_ub)((((_udb)max + min) >> 1) + 1);
-							/* One section is done! */
-						}
-						else
-						{
-							min = mid;
-							mid = (_ub)((((_udb)max + min + 1) >> 1));
-						}
-						if (!pbkMoveBint(&D, b))
-						{
-							rtn = false;
-							goto Lbl_Failure;
-						}
-						if (!pbkMoveBint(&Q, &C))
-						{
-							rtn = false;
-							goto Lbl_Failure;
-						}
-					}
-				Lbl_Solved:
-					if (NULL != q)
-					{
-						/* Reverse quotient. */
-						k = GETFLAG(q) >> 1;
-						j = GETFLAG(q) & 1;
-						for (i = 0; i < (_ib)k; ++i)
-						{
-							u = q->data[i];
-							q->data[i] = q->data[k + i + j];
-							q->data[k + i + j] = u;
-						}
-					}
-				Lbl_Failure:
-					pbkFreeBint(&D);
-					pbkFreeBint(&Q);
-					pbkFreeBint(&C);
-					pbkFreeBint(&T);
-					pbkFreeBint(&X);
-					return rtn;
-				}
-				return false;
-			}
-		}
-		else
-		{
-			register int rtn = false;
-			register _ib fa, fb;
-
-			fa = GETFLAG(a);
-			fb = GETFLAG(b);
-
-			SETFLAG(a, GETABS(GETFLAG(a)));
-			SETFLAG(b, GETABS(GETFLAG(b)));
-
-			rtn = pbkDivideBint(q, r, a, b);
-
-			SETFLAG(a, fa);
-			SETFLAG(b, fb);
-
-			if (rtn)
-			{
-				if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
-				{
-					if (NULL != q)
-						SETFLAG(q, -GETFLAG(q));
-					if (NULL != r)
-						SETFLAG(r, -GETFLAG(r));
-				}
-			}
-
-			return rtn;
-		}
-	}
-}
-
-/* This section of current C file is for big numbers. */
-static bool _pbkAddAbstractBnum     (P_BNUM c, P_BNUM a, P_BNUM b);
-static bool _pbkMultiplyAbstractBnum(P_BNUM c, P_BNUM a, P_BNUM b);
-
-/* Function name: pbkInitBnum
- * Description:   Initialize a big number.
- * Parameters:
- *        pbn Pointer to a big number.
- *       base Base value of the big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Big number structure shall be initialized to 0.
- * Tip:           This function is used only to initialize big numbers,
- *                but not for change the value or capacity for any big number.
- */
-bool pbkInitBnum(P_BNUM pbn, _ub base)
-{
-	if (NULL == pbn->data)
-	{
-		SETFLAG(pbn, 1);
-		SETSIZE(pbn, BNUM_INIT_SIZE);
-		SETINCL(pbn, BNUM_INIT_INCL);
-		SETBASE(pbn, base);
-		pbn->data = (char *)malloc(GETSIZE(pbn) + GETINCL(pbn));
-		if (NULL == pbn->data)
-		{
-			SETFLAG(pbn, 0);
-			SETSIZE(pbn, 0U);
-		}
-		else
-		{
-			pbn->data[0] = 0;
-			return true;
-		}
-	}
-	return false;
-}
-
-/* Function name: pbkReallocBnum
- * Description:   Reallocate a big number.
- * Parameters:
- *        pbi Pointer to a big number.
- *       size New size of capacity to big number.
- *       binc Increase the capacity or decrease it.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function can be used to initialize big numbers.
- */
-bool pbkReallocBnum(P_BNUM pbn, _ub size, bool binc)
-{
-	if (!binc && (GETSIZE(pbn) == size))
-	{
-		return true;
-	}
-	else if (binc && (GETSIZE(pbn) >= size))
-	{
-		return true;
-	}
-	else
-	{
-		char * pnew = (char *)realloc(pbn->data, SETSIZE(pbn, (binc ? size + GETINCL(pbn) : size)));
-		if (NULL != pnew)
-		{
-			pbn->data = pnew;
-			return true;
-		}
-		else
-		{
-			SETFLAG(pbn, 0);
-			SETSIZE(pbn, 0U);
-			pbn->data = NULL;
-			return false;
-		}
-	}
-}
-
-/* Function name: pbkFreeBnum
- * Description:   Initialize a big number.
- * Parameter:
- *       pbi Pointer to a big number.
- * Return value:  N/A.
- */
-void pbkFreeBnum(P_BNUM pbn)
-{
-	if (pbn->data)
-		free(pbn->data);
-	pbn->data = NULL;
-	SETFLAG(pbn, 0);
-	SETSIZE(pbn, 0U);
-}
-
-/* Function name: pbkCreateBnum
- * Description:   Create a big number in main memory.
- * Parameter:
- *      base Base value you want to set to big number.
- * Return value:  Pointer to new created big number structure.
- */
-P_BNUM pbkCreateBnum(_ub base)
-{
-	register P_BNUM pbn = malloc(sizeof(BINT));
-	if (NULL != pbn)
-	{
-		memset(pbn, 0, sizeof(BNUM));
-		if (!pbkInitBnum(pbn, base))
-		{
-			free(pbn);
-			pbn = NULL;
-		}
-	}
-	return pbn;
-}
-
-/* Function name: pbkDeleteBnum
- * Description:   Deallocate a big number from main memory.
- * Parameter:
- *       pbi Pointer to a big number.
- * Return value:  N/A.
- */
-void pbkDeleteBnum(P_BNUM pbn)
-{
-	pbkFreeBnum(pbn);
-	free(pbn);
-}
-
-/* Function name: pbkMoveBnum
- * Description:   Move the memory of a big number to another big number.
- * Parameters:
- *         a Pointer to a big number.
- *         b Pointer to another big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Parameter a and b shall not be NULL.
- * Tip:           After invoking, the capacity of a will equal to b's.
- */
-bool pbkMoveBnum(P_BNUM a, P_BNUM b)
-{
-	if (pbkReallocBnum(a, GETSIZE(b), true))
-	{
-		memmove(a->data, b->data, GETABS(GETFLAG(b)));
-		SETFLAG(a, GETFLAG(b));
-		SETBASE(a, GETBASE(b));
-		return true;
-	}
-	return false;
-}
-
-/* Function name: pbkIbToBnum
- * Description:   Convert an integer to big number.
- * Parameters:
- *        pbn Pointer to a big number.
- *          n Value you want to set to the big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function will not change pbn's capacity.
- */
-bool pbkIbToBnum(P_BNUM pbn, _ib n)
-{
-	register _ib sign = GETSGN(n);
-	if (pbkIsNotANumber(pbn))
-		return false;
-	if (n == 0)
-	{
-		SETFLAG(pbn, 1);
-		pbn->data[0] = 0;
-		return true;
-	}
-
-	n = GETABS(n);
-
-	for (SETFLAG(pbn, 0); n > 0;)
-	{
-		register _ub base = pbn->base;
-
-		if (GETFLAG(pbn) + 1 >= (_ib)GETSIZE(pbn))
-		{
-			if (!pbkReallocBnum(pbn, GETSIZE(pbn), true))
-				return false;
-		}
-
-		pbn->data[GETFLAG(pbn)++] = n % base;
-		n /= base;
-	}
-
-	SETFLAG(pbn, GETFLAG(pbn) * sign);
-
-	return true;
-}
-
-/* Function name: pbkDecimalSzToBnum
- * Description:   Convert a base 10 presented string to big number.
- * Parameters:
- *        pbn Pointer to a big number.
- *        str Pointer to a string.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       This string shall contain ASCII number 0-9. And Shall not contain minus sign(-).
- */
-bool pbkDecimalSzToBnum(P_BNUM pbn, const char * str)
-{
-	register size_t i, j = strlen(str);
-	if (pbkReallocBnum(pbn, (_ub)j, true))
-	{
-		register char c;
-		SETBASE(pbn, 10);
-		for (i = 0, --j; j > 0; --j, ++i)
-		{
-			c = str[j];
-			if (!(c >= '0' && c <= '9'))
-				return false;
-			pbn->data[i] = c - '0';
-		}
-		pbn->data[i] = str[j] - '0';
-		SETFLAG(pbn, (_ib)i + 1);
-		pbkShrinkZeroFlag(pbn);
-		return true;
-	}
-	return false;
-}
-
-/* Function name: pbkPrintBnum
- * Description:   Print a big number.
- * Parameter:
- *       pbn Pointer to a big number.
- * Return value:  N/A.
- */
-void pbkPrintBnum(P_BNUM pbn)
-{
-	if (pbkIsNotANumber(pbn))
-	{
-		printf("NaN");
-		return;
-	}
-	else
-	{
-		register size_t i;
-		register _ub base = pbn->base;
-		if (GETFLAG(pbn) < 0)
-			putchar('-');
-		for (i = GETABS(GETFLAG(pbn)); i > 0; --i)
-		{
-			switch (base)
-			{
-			case 8:
-			case 10:
-				putchar('0' + pbn->data[i - 1]);
-				break;
-			case 16:
-				printf("%x", pbn->data[i - 1]);
-			}
-		}
-	}
-}
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _pbkAddAbstractBnum
- * Description:   Adds two positive big numbers and stores the result to c.
- * Parameters:
- *          c Pointer to a big number.
- *          a Pointer to a big number.
- *          b Pointer to a big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Value of parameter a and b shall be positive.
- * Tip:           c := a + b;
- */
-static bool _pbkAddAbstractBnum(P_BNUM c, P_BNUM a, P_BNUM b)
-{
-	if (pbkReallocBnum(c, GETSIZE(a) > GETSIZE(b) ? GETSIZE(a) : GETSIZE(b), true))
-	{
-		register _ub base = c->base;
-		register size_t i;
-		register char carry;
-		register _ib fa, fb;
-
-		fa = GETFLAG(a);
-		fb = GETFLAG(b);
-
-		SETFLAG(a, GETABS(GETFLAG(a)));
-		SETFLAG(b, GETABS(GETFLAG(b)));
-
-		for (i = 0, carry = 0; i < (_ub)GETFLAG(a) || i < (_ub)GETFLAG(b) || carry; ++i)
-		{
-			carry += (i < (_ub)GETFLAG(a) ? a->data[i] : 0) + (i < (_ub)GETFLAG(b) ? b->data[i] : 0);
-			c->data[i] = carry % base;
-			carry /= base;
-		}
-
-		SETFLAG(a, fa);
-		SETFLAG(b, fb);
-
-		SETFLAG(c, (_ib)i);
-
-		return true;
-	}
-	return false;
-}
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _pbkMultiplyAbstractBnum
- * Description:   Subtracts two positive big numbers and stores the result to c.
- * Parameters:
- *          c Pointer to a big number.
- *          a Pointer to a big number.
- *          b Pointer to a big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Value of parameter a and b shall be positive.
- * Tip:           c := a - b;
- */
-static bool _pbkMultiplyAbstractBnum(P_BNUM c, P_BNUM a, P_BNUM b)
-{
-	BNUM B = { 0 };
-
-	register _ib fa, fb;
-
-	fa = GETFLAG(a);
-	fb = GETFLAG(b);
-
-	SETFLAG(a, GETABS(GETFLAG(a)));
-	SETFLAG(b, GETABS(GETFLAG(b)));
-
-	if (pbkReallocBnum(c, GETFLAG(a) + GETFLAG(b), true))
-	{
-		register size_t i;
-		register char k;
-
-		if (!pbkInitBnum(&B, GETBASE(b)))
-			return false;
-
-		if (!pbkMoveBnum(&B, b))
-			return false;
-
-		c->data[0] = 0;
-		SETFLAG(c, 1);
-
-		for (i = 0, k = a->data[i]; i < (_ub)GETFLAG(a); ++i, k = a->data[i])
-		{
-			while (k--)
-				if (!_pbkAddAbstractBnum(c, c, &B)) /* ith digit is k, so we add k times. */
-					goto Lbl_Failed;
-
-			/* Multiply by 10. */
-			if (GETFLAG(&B) + 1 >= (_ib)GETSIZE(&B))
-			{
-				if (!pbkReallocBnum(&B, GETSIZE(&B) + 1, true))
-					goto Lbl_Failed;
-			}
-			memmove(B.data + 1, B.data, GETABS(GETFLAG(&B)));
-			B.data[0] = 0;
-			++GETFLAG(&B);
-		}
-
-		pbkShrinkZeroFlag(c);
-
-		pbkFreeBnum(&B);
-
-		SETFLAG(a, fa);
-		SETFLAG(b, fb);
-
-		return true;
-	}
-
-Lbl_Failed:
-	pbkFreeBnum(&B);
-
-	SETFLAG(a, fa);
-	SETFLAG(b, fb);
-
-	return false;
-}
-
-/* Function name: pbkBintToDecimalBnum
- * Description:   Convert a big integer to base 10 big number.
- * Parameters:
- *          x Pointer to a big number.
- *          a Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function is used to output a big integer.
- */
-bool pbkBintToDecimalBnum(P_BNUM x, P_BINT a)
-{
-	BNUM B = { 0 }, ak = { 0 }, X = { 0 };
-	if (pbkIsNotANumber(a))
-		return false;
-	else
-	{
-		register size_t i, j;
-		register _ub as;
-		
-		pbkInitBnum(&ak, 10);
-		pbkInitBnum(&B, 10);
-		pbkInitBnum(&X, 10);
-
-		if (!pbkIbToBnum(&X, 0))
-			goto Lbl_Failed;
-		if (!pbkIbToBnum(&B, 2))
-			goto Lbl_Failed;
-		if (!pbkIbToBnum(&ak, 1))
-			goto Lbl_Failed;
-
-		for (i = GETABS(GETFLAG(a)); i > 0; --i)
-		{
-			as = a->data[i - 1];
-			for (j = sizeof(_ub) * CHAR_BIT; j > 0; --j)
-			{
-				if (!pbkMoveBnum(&X, x))
-					goto Lbl_Failed;
-				if (!_pbkMultiplyAbstractBnum(x, &B, &X))
-					goto Lbl_Failed;
-				if (as & (1 << (j - 1)))
-					if (!_pbkAddAbstractBnum(x, x, &ak))
-						goto Lbl_Failed;
-			}
-		}
-		pbkFreeBnum(&B);
-		pbkFreeBnum(&ak);
-		pbkFreeBnum(&X);
-		GETFLAG(x) *= GETSGN(GETFLAG(a));
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBnum(&B);
-	pbkFreeBnum(&ak);
-	pbkFreeBnum(&X);
-	return false;
-}
-
-/* Function name: pbkDecimalBnumToBint
- * Description:   Convert a big number to base 2 big integer.
- * Parameters:
- *          x Pointer to a big integer.
- *          a Pointer to a big number.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           This function is used to input a big integer from a big number.
- */
-bool pbkDecimalBnumToBint(P_BINT x, P_BNUM a)
-{
-	BINT B = { 0 }, ak = { 0 }, X = { 0 };
-	if (pbkIsNotANumber(a))
-		return false;
-	else
-	{
-		register _ub d;
-		register size_t i;
-		
-		pbkInitBint(&B, 10);
-		pbkInitBint(&ak, 0);
-		pbkInitBint(&X, 0);
-
-		SETFLAG(x, 1);
-		x->data[0] = 0;
-
-		for (i = GETABS(GETFLAG(a)); i > 0; --i)
-		{
-			if (!pbkMoveBint(&X, x))
-				goto Lbl_Failed;
-			if (!pbkMultiplyBint(x, &B, &X))
-				goto Lbl_Failed;
-			d = ak.data[0] = a->data[i - 1];
-			if (d)
-				if (!pbkAddBint(x, x, &ak))
-					goto Lbl_Failed;
-		}
-		pbkFreeBint(&B);
-		pbkFreeBint(&ak);
-		pbkFreeBint(&X);
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&B);
-	pbkFreeBint(&ak);
-	pbkFreeBint(&X);
-	GETFLAG(x) *= GETSGN(GETFLAG(a));
-	return false;
-}
-
+﻿/*
+ * Name:        pbk.c
+ * Description: Portable big integer library kernel.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     0520240323B1019261800L03919
+ * License:     GPLv3.
+ */
+
+#include "pbb.h"
+#include "pbp.h"
+#include <stdio.h>  /* Using function putchar, printf. */
+#include <stdlib.h> /* Using function memcpy, memmove, malloc, realloc. */
+#include <string.h> /* Using function memset, strlen. */
+#include <math.h>   /* Using function log. */
+#include <stdint.h> /* Using type uint64_t. */
+
+/* Power tables of radix conversion are shared by threads.
+ * Readers load the number of powers without a lock. Writers append powers under a lock
+ * and store the new number after the powers are complete.
+ */
+#ifdef PBK_NO_THREADS
+#define PBK_POW_LOCK()
+#define PBK_POW_UNLOCK()
+#define PBK_LOAD(v)      (v)
+#define PBK_STORE(v, x)  ((v) = (x))
+#elif defined _WIN32
+#include <Windows.h>
+static SRWLOCK _pbkPowLock = SRWLOCK_INIT;
+#define PBK_POW_LOCK()   AcquireSRWLockExclusive(&_pbkPowLock)
+#define PBK_POW_UNLOCK() ReleaseSRWLockExclusive(&_pbkPowLock)
+#define PBK_LOAD(v)      ((size_t)InterlockedCompareExchangePointer((PVOID volatile *)&(v), NULL, NULL))
+#define PBK_STORE(v, x)  InterlockedExchangePointer((PVOID volatile *)&(v), (PVOID)(x))
+#else
+#include <pthread.h>
+static pthread_mutex_t _pbkPowLock = PTHREAD_MUTEX_INITIALIZER;
+#define PBK_POW_LOCK()   pthread_mutex_lock(&_pbkPowLock)
+#define PBK_POW_UNLOCK() pthread_mutex_unlock(&_pbkPowLock)
+#define PBK_LOAD(v)      __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define PBK_STORE(v, x)  __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+#endif
+
+/* Thresholds used by the kernel. */
+PBKTUNE gTuneTable = { BINT_MUL_KARA, BINT_MUL_TOOM, BINT_MUL_FFT, BINT_MUL_PAR, BINT_MUL_PFFT, BINT_DIV_BZ, BINT_DIV_NEWTON, BINT_CONV_DC };
+
+/* File level function declarations. */
+static _ubdiv_t _ubdiv(_ub numerator, _ub denominator);
+static _ub *    _pbkPadBint(_ub * p, P_BINT a, size_t n);
+static bool     _pbkPowerOfTwoBint(P_BINT b, size_t * pk);
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _ubdiv
+ * Description:   Compute a quotient that truncates toward 0 and the corresponding remainder.
+ * Parameters:
+ *  numerator Numerator.
+ *denominator Denominator.
+ * Return value:  A _ubdiv_t structure which contains the result.
+ */
+static _ubdiv_t _ubdiv(_ub numerator, _ub denominator)
+{
+	_ubdiv_t result;
+	/* Just give me some optimization. */
+	result.quot = numerator / denominator;
+	result.rem  = numerator % denominator;
+	return result;
+}
+
+/* Function name: pbkInitBint
+ * Description:   Initialize a big integer.
+ * Parameters:
+ *        pbi Pointer to a big integer.
+ *          i Initial value you want to set to big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Big integer structure shall be initialized to 0.
+ * Tip:           This function is used only to initialize big integers,
+ *                but not for change the value or capacity for any big integer.
+ */
+bool pbkInitBint(P_BINT pbi, _ib i)
+{
+	if (NULL == pbi->data)
+	{
+		SETFLAG(pbi, (i == 0 ? 1 : GETSGN(i)));
+		SETSIZE(pbi, BINT_INIT_SIZE);
+		SETINCL(pbi, BINT_INIT_INCL);
+		pbi->data = (_ub *)malloc(sizeof(_ub) * (GETSIZE(pbi) + GETINCL(pbi)));
+		if (NULL != pbi->data)
+		{
+			pbi->data[0] = GETABS(i);
+			return true;
+		}
+		else
+		{
+			SETFLAG(pbi, 0);
+			SETSIZE(pbi, 0U);
+		}
+	}
+	return false;
+}
+
+/* Function name: pbkReallocBint
+ * Description:   Reallocate a big integer.
+ * Parameters:
+ *        pbi Pointer to a big integer.
+ *       size New size of capacity to big integer.
+ *       binc Increase the capacity or decrease it.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           This function can be used to initialize big integers.
+ */
+bool pbkReallocBint(P_BINT pbi, _ub size, bool binc)
+{
+	if (!binc && (GETSIZE(pbi) == size))
+	{
+		return true;
+	}
+	else if (binc && (GETSIZE(pbi) >= size))
+	{
+		return true;
+	}
+	else
+	{
+		_ub * pnew = (_ub *)realloc(pbi->data, SETSIZE(pbi, (binc ? size + GETINCL(pbi) : size)) * sizeof(_ub));
+		if (NULL != pnew)
+		{
+			pbi->data = pnew;
+			return true;
+		}
+		else
+		{
+			SETFLAG(pbi, 0);
+			SETSIZE(pbi, 0U);
+			pbi->data = NULL;
+			return false;
+		}
+	}
+}
+
+/* Function name: pbkFreeBint
+ * Description:   Initialize a big integer.
+ * Parameter:
+ *       pbi Pointer to a big integer.
+ * Return value:  N/A.
+ */
+void pbkFreeBint(P_BINT pbi)
+{
+	if (pbi->data)
+		free(pbi->data);
+	pbi->data = NULL;
+	SETFLAG(pbi, 0);
+	SETSIZE(pbi, 0U);
+}
+
+/* Function name: pbkCreateBint
+ * Description:   Create a big integer in main memory.
+ * Parameter:
+ *         i Initial value you want to set to big integer.
+ * Return value:  Pointer to new created big integer structure.
+ */
+P_BINT pbkCreateBint(_ib i)
+{
+	register P_BINT pbi = malloc(sizeof(BINT));
+	if (NULL != pbi)
+	{
+		memset(pbi, 0, sizeof(BINT));
+		if (!pbkInitBint(pbi, i))
+		{
+			free(pbi);
+			pbi = NULL;
+		}
+	}
+	return pbi;
+}
+
+/* Function name: pbkDeleteBint
+ * Description:   Deallocate a big integer from main memory.
+ * Parameter:
+ *       pbi Pointer to a big integer.
+ * Return value:  N/A.
+ */
+void pbkDeleteBint(P_BINT pbi)
+{
+	pbkFreeBint(pbi);
+	free(pbi);
+}
+
+/* Function name: pbkMoveBint
+ * Description:   Move the memory of a big integer to another big integer.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *          b Pointer to another big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Parameter a and b shall not be NULL.
+ * Tip:           After invoking, the capacity of a will equal to b's. 
+ */
+bool pbkMoveBint(P_BINT a, P_BINT b)
+{
+	if (pbkReallocBint(a, GETSIZE(b), true))
+	{
+		memmove(a->data, b->data, GETABS(GETFLAG(b)) * sizeof(_ub));
+		SETFLAG(a, GETFLAG(b));
+		return true;
+	}
+	return false;
+}
+
+/* Function name: pbkCopyBint
+ * Description:   Copy a big integer.
+ * Parameter:
+ *         a Pointer to a big integer.
+ * Return value:  Pointer to the copy of big integer a.
+ */
+P_BINT pbkCopyBint(P_BINT a)
+{
+	register P_BINT pbi = pbkCreateBint(0);
+	if (NULL != pbi)
+	{
+		if (pbkMoveBint(pbi, a))
+			return pbi;
+		pbkFreeBint(pbi);
+		pbi = NULL;
+	}
+	return pbi;
+}
+
+/* Function name: pbkIbToBint
+ * Description:   Convert an integer to big integer.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *          i Value you want to set to the big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           This function will not change a's capacity.
+ */
+bool pbkIbToBint(P_BINT a, _ib i)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	a->data[0] = GETABS(i);
+	SETFLAG(a, 0 == GETSGN(i) ? 1 : GETSGN(i));
+	return true;
+}
+
+/* Function name: pbkBintToIb
+ * Description:   Convert a big integer to signed block integer.
+ * Parameter:
+ *         a Pointer to a big integer.
+ * Return value:  Converted signed block integer.
+ *                If this function fails to convert, it would return 0.
+ * Caution:       Only the latest block of big integer can be converted.
+ */
+_ib pbkBintToIb(P_BINT a)
+{
+	if (pbkIsNotANumber(a))
+		return 0;
+	return GETFLAG(a) >= 0 ? (_ib)*a->data : -(_ib)*a->data;
+}
+
+/* Function name: pbkCompareBint
+ * Description:   Compare two big integers.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *          b Pointer to another big integer.
+ * Return value:  0:  a == b. Or can not compare.
+ *                1:  a > b.
+ *                -1: a < b.
+ * Caution:       If a or b is NaN, function will return 0.
+ */
+int pbkCompareBint(P_BINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return 0; /* Can not compare. */
+	else
+	{
+		if (GETFLAG(a) == GETFLAG(b) && a->data == b->data)
+			return 0;
+		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 . +1. */
+		{
+			if (GETFLAG(a) > GETFLAG(b))
+			{
+				return 1;
+			}
+			else if (GETFLAG(a) < GETFLAG(b))
+			{
+				return -1;
+			}
+			else
+			{
+				_ub f = 1;
+				if (*(char *)&f)
+				{	/* Little endian. */
+					register size_t i, j;
+					register _udb x, y;
+					if (0 == (GETFLAG(a) & 0x1)) /* 0 == GETFLAG(a) % 2; */
+					{
+						for (i = GETFLAG(a); i > 0; i -= 2)
+						{
+							j = i - 2;
+							x = *(_udb *)&j[a->data];
+							y = *(_udb *)&j[b->data];
+							if (x > y)
+								return 1;
+							else if (x < y)
+								return -1;
+						}
+					}
+					else
+					{
+						if (GETFLAG(a) > 2)
+						{
+							for (i = GETFLAG(a); i > 1; i -= 2)
+							{
+								j = i - 2;
+								x = *(_udb *)&j[a->data];
+								y = *(_udb *)&j[b->data];
+								if (x > y)
+									return 1;
+								else if (x < y)
+									return -1;
+							}
+						}
+						x = 0[a->data];
+						y = 0[b->data];
+						if (x > y)
+							return 1;
+						else if (x < y)
+							return -1;
+					}
+					return 0;
+				}
+				else /* Big endian. */
+				{
+					register size_t i, j;
+					register _ub x, y;
+					for (i = GETFLAG(a); i > 0; --i)
+					{
+						j = i - 1;
+						x = j[a->data];
+						y = j[b->data];
+						if (x > y)
+							return 1;
+						else if (x < y)
+							return -1;
+					}
+					return 0;
+				}
+			}
+		}
+		else if (GETFLAG(a) < 0 && GETFLAG(b) > 0) /* -1 . +1. */
+		{
+			return -1;
+		}
+		else if (GETFLAG(a) > 0 && GETFLAG(b) < 0) /* +1 . -1. */
+		{
+			return 1;
+		}
+		else /* -1 . -1. */
+		{
+			register int r;
+			register _ib fa, fb;
+
+			fa = GETFLAG(a);
+			fb = GETFLAG(b);
+
+			SETFLAG(a, GETABS(GETFLAG(a)));
+			SETFLAG(b, GETABS(GETFLAG(b)));
+
+			r = -pbkCompareBint(a, b);
+
+			SETFLAG(a, fa);
+			SETFLAG(b, fb);
+
+			return r;
+		}
+	}
+}
+
+/* Function name: pbkAddBint
+ * Description:   Adds two big integers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           c := a + b;
+ */
+bool pbkAddBint(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (pbkReallocBint(c, GETSIZE(a) > GETSIZE(b) ? GETSIZE(a) : GETSIZE(b), true))
+	{
+		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 + +1. */
+		{
+			register size_t i, j = GETMIN(GETFLAG(a), GETFLAG(b)), k = GETMAX(GETFLAG(a), GETFLAG(b));
+			register _udb r = 0;
+			P_BINT pir = GETFLAG(a) > GETFLAG(b) ? a : b;
+
+			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+				return false;
+
+			if (a == b && a->data == b->data) /* a + a = 2 * a. */
+			{
+				if (c->data != a->data)
+					pbkMoveBint(c, a);
+
+				if (!pbkLeftShiftBint(c, 0, 1))
+					return false;
+
+				return true;
+			}
+
+			for (i = 0; i < j; ++i)
+			{
+				r = CARRY(r) + (_udb)a->data[i] + (_udb)b->data[i];
+				c->data[i] = (_ub)r;
+			}
+			for (; i < k; ++i)
+			{
+				r = CARRY(r) + (_udb)pir->data[i];
+				c->data[i] = (_ub)r;
+			}
+
+			if (GETFLAG(c) + 1 >= (_ib)GETSIZE(c))
+			{
+				if (!pbkReallocBint(c, GETSIZE(c), true))
+					return false;
+			}
+			c->data[i] = (_ub)CARRY(r);
+			SETFLAG(c, (_ib)i + 1);
+			pbkShrinkZeroFlag(c);
+			return true;
+		}
+		else if (GETFLAG(a) < 0 && GETFLAG(b) > 0) /* -1 + +1. */
+		{
+			register int r;
+			register _ib fa;
+
+			fa = GETFLAG(a);
+
+			SETFLAG(a, -GETFLAG(a));
+
+			r = pbkSubtractBint(c, b, a);
+
+			SETFLAG(a, fa);
+
+			return r;
+		}
+		else if (GETFLAG(a) > 0 && GETFLAG(b) < 0) /* +1 + -1. */
+		{
+			return pbkSubtractBint(c, a, b);;
+		}
+		else /* -1 + -1. */
+		{
+			register int r;
+			register _ib fa, fb;
+
+			fa = GETFLAG(a);
+			fb = GETFLAG(b);
+
+			SETFLAG(a, GETABS(GETFLAG(a)));
+			SETFLAG(b, GETABS(GETFLAG(b)));
+
+			r = pbkAddBint(c, a, b);
+
+			SETFLAG(a, fa);
+			SETFLAG(b, fb);
+
+			if (r)
+				SETFLAG(c, -GETFLAG(c));
+
+			return r;
+		}
+	}
+	return false;
+}
+
+/* Function name: pbkSubtractBint
+ * Description:   Subtracts two big integers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           c := a - b;
+ */
+bool pbkSubtractBint(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (pbkReallocBint(c, GETSIZE(a) > GETSIZE(b) ? GETSIZE(a) : GETSIZE(b), false))
+	{
+		if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+			return false;
+		else if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 - +1. */
+		{
+			if (pbkCompareBint(a, b) >= 0)
+			{
+				register size_t i, j = GETMIN(GETFLAG(a), GETFLAG(b)), k = GETMAX(GETFLAG(a), GETFLAG(b));
+				register _ub x, y;
+				register bool borrow = false;
+
+				if (a == b && a->data == b->data) /* a - a = 0. */
+				{
+					pbkFreeBint(c);
+
+					if (!pbkInitBint(c, 0))
+						return false;
+
+					return true;
+				}
+				
+				for (i = 0; i < j; ++i)
+				{
+					y = a->data[i];
+
+					if (borrow)
+					{
+						x = y - 1;
+					}
+					else
+					{
+						x = y;
+					}
+
+					y = b->data[i];
+					c->data[i] = x - y;
+
+					if (x < y)
+					{
+						borrow = true;
+					}
+					else
+					{
+						borrow = false;
+					}
+				}
+				for (; i < k; ++i)
+				{
+					y = a->data[i];
+
+					if (borrow)
+					{
+						x = y - 1;
+					}
+					else
+					{
+						x = y;
+					}
+
+					c->data[i] = x;
+
+					if (0 == y)
+						borrow = true;
+					else
+						borrow = false;
+				}
+				SETFLAG(c, (_ib)i);
+				pbkShrinkZeroFlag(c);
+				if (GETFLAG(c) < (_ib)(GETSIZE(c) - GETINCL(c)))
+				{
+					if (!pbkReallocBint(c, GETSIZE(c) - GETINCL(c), false))
+						return false;
+				}
+				return true;
+			}
+			else /* +1 - +10. */
+			{
+				register bool r;
+
+				r = pbkSubtractBint(c, b, a);
+
+				if (r)
+					SETFLAG(c, -GETFLAG(c));
+
+				return r;
+			}
+
+		}
+		else
+		{
+			register int r;
+			register _ib fb;
+
+			fb = GETFLAG(b);
+
+			SETFLAG(b, -GETFLAG(b));
+
+			r = pbkAddBint(c, a, b);
+
+			SETFLAG(b, fb);
+
+			return r;
+		}
+	}
+	return false;
+}
+
+/* Function name: pbkLeftShiftBint
+ * Description:   Left shift a big integer.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *     blocks Blocks of integer you want to shift.
+ *       bits Bits of integer you want to shift.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+bool pbkLeftShiftBint(P_BINT a, _ub blocks, _ub bits)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	else
+	{
+		register _ubdiv_t u = _ubdiv(bits, UB_BIT);
+		register size_t i, j;
+		register _udb n = 0;
+
+		blocks += u.quot;
+
+		/* Handle blocks first. */
+		if (GETFLAG(a) + blocks + (u.rem ? 1 : 0) >= GETSIZE(a))
+		{
+			if (!pbkReallocBint(a, GETSIZE(a) + blocks + (u.rem ? 1 : 0), true))
+				return false;
+		}
+		if (blocks)
+		{
+			memmove(a->data + blocks, a->data, GETABS(GETFLAG(a)) * sizeof(_ub));
+			memset(a->data, 0, sizeof(_ub) * blocks);
+			SETFLAG(a, (GETFLAG(a) >= 0 ? (_ib)(GETFLAG(a) + blocks) : -(_ib)(GETABS(GETFLAG(a)) + blocks)));
+		}
+
+		/* Handle bits next. */
+		if (u.rem)
+		{
+			j = GETABS(GETFLAG(a));
+			a->data[j] = 0;
+			for (i = j; i > 0; --i)
+			{
+				n = (_udb)a->data[i - 1] << u.rem;
+				a->data[i - 1] = (_ub)n;
+				a->data[i] |= CARRY(n);
+			}
+			SETFLAG(a, (GETFLAG(a) >= 0 ? GETFLAG(a) + 1 : -(_ib)(GETABS(GETFLAG(a)) + 1)));
+			pbkShrinkZeroFlag(a);
+		}
+
+		return true;
+	}
+}
+
+/* Function name: pbkRightShiftBint
+ * Description:   Right shift a big integer.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *     blocks Blocks of integer you want to shift.
+ *       bits Bits of integer you want to shift.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+bool pbkRightShiftBint(P_BINT a, _ub blocks, _ub bits)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	else
+	{
+		register _ubdiv_t u = _ubdiv(bits, UB_BIT);
+		register _ub n, n2;
+		register size_t i;
+
+		/* Handle blocks first. */
+		if (blocks)
+		{
+			register _ib b = GETABS(GETFLAG(a)) - blocks;
+			memmove(a->data, a->data + blocks, ((_ib)b >= 0 ? (_ub)b : GETABS(GETFLAG(a))) * sizeof(_ub));
+			b = b > 0 ? b : 1;
+			SETFLAG(a, (GETFLAG(a) >= 0 ? b : -b));
+		}
+
+		if ((_ub)(GETFLAG(a) - (u.rem ? 1 : 0)) - blocks < GETSIZE(a) - GETINCL(a))
+		{
+			if (!pbkReallocBint(a, GETSIZE(a) - GETINCL(a), false))
+				return false;
+		}
+
+		/* Handle bits next. */
+		if (u.rem)
+		{
+			for (n2 = n = 0, i = GETABS(GETFLAG(a)); i > 0; --i)
+			{
+				n = a->data[i - 1] << (UB_BIT - u.rem);
+				a->data[i - 1] >>= u.rem;
+				a->data[i - 1] |= n2;
+				n2 = n;
+				
+			}
+			pbkShrinkZeroFlag(a);
+		}
+
+		return true;
+	}
+}
+
+/* Function name: pbkMultiplyBintOld
+ * Description:   Multiplies two big integers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           c := a * b;
+ */
+bool pbkMultiplyBintOld(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 * +1. */
+	{
+		if (GETFLAG(a) > GETFLAG(b))
+		{
+			return pbkMultiplyBintOld(c, b, a);
+		}
+		else /* GETFLAG(a) <= GETFLAG(b). */
+		{
+			register size_t i, j, k = GETFLAG(a), l = 0, m = 0;
+			register _ub n;
+			BINT B = { 0 }, C = { 0 };
+			bool r = true;
+
+			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+				return false;
+
+			SETFLAG(c, 1);
+			c->data[0] = 0;
+
+			if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
+				return true;
+
+			if (!pbkMoveBint(&B, b))
+			{
+				r = false;
+				goto Lbl_Clear;
+			}
+			
+			for (i = 0; i < k; ++i)
+			{
+				n = a->data[i];
+
+				if (n)
+				{
+					for (j = 0; j < UB_BIT; ++j)
+					{
+						if (((_ub)1 << j) & n)
+						{
+							if (!pbkLeftShiftBint(&B, (_ub)m, (_ub)l))
+							{
+								r = false;
+								goto Lbl_Clear;
+							}
+							if (!pbkMoveBint(&C, c))
+							{
+								r = false;
+								goto Lbl_Clear;
+							}
+							if (!pbkAddBint(c, &B, &C))
+							{
+								r = false;
+								goto Lbl_Clear;
+							}
+							l = 1;
+							m = 0;
+						}
+						else
+						{
+							++l;
+						}
+					}
+				}
+				else
+				{
+					++m;
+				}
+			}
+		Lbl_Clear:
+			pbkFreeBint(&B);
+			pbkFreeBint(&C);
+			return r;
+		}
+	}
+	else
+	{
+		register int r;
+		register _ib fa, fb;
+
+		fa = GETFLAG(a);
+		fb = GETFLAG(b);
+
+		SETFLAG(a, GETABS(GETFLAG(a)));
+		SETFLAG(b, GETABS(GETFLAG(b)));
+
+		r = pbkMultiplyBintOld(c, a, b);
+
+		SETFLAG(a, fa);
+		SETFLAG(b, fb);
+
+		if (r)
+		{
+			if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
+				SETFLAG(c, -GETFLAG(c));
+		}
+
+		return r;
+	}
+}
+
+/* Function name: pbkMultiplyBintNew
+ * Description:   Multiplies two big integers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           c := a * b;
+ */
+bool pbkMultiplyBintNew(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +1 * +1. */
+	{
+		if (GETABS(GETFLAG(a)) <= GETABS(GETFLAG(b)))
+		{
+			register size_t i, j, k = GETFLAG(a), l = GETFLAG(b), m;
+			register _udb carry;
+			register _ub  t;
+			BINT A = { 0 };
+			bool r = true;
+
+			if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+				return false;
+
+			SETFLAG(c, 1);
+			c->data[0] = 0;
+
+			if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
+				return true;
+
+			if (!pbkReallocBint(&A, k + l + 1, true))
+			{
+				r = false;
+				goto Lbl_Clear;
+			}
+
+			for (i = 0; i < k; ++i)
+			{
+				SETFLAG(&A, 1);
+				A.data[0] = 0;
+				carry = 0;
+				for (j = 0, m = l; j < l; ++j)
+				{
+					A.data[j] = CARRY(carry);
+					carry = (_udb)a->data[i] * (_udb)b->data[j] + (_udb)A.data[j];
+					A.data[j] = (_ub)carry;
+				}
+				t = CARRY(carry);
+				if (t)
+				{
+					A.data[j] = t;
+					++m;
+				}
+
+				SETFLAG(&A, (_ib)m);
+
+				if (!pbkLeftShiftBint(&A, i, 0))
+				{
+					r = false;
+					goto Lbl_Clear;
+				}
+				if (!pbkAddBint(c, c, &A))
+				{
+					r = false;
+					goto Lbl_Clear;
+				}
+			}
+		Lbl_Clear:
+			pbkFreeBint(&A);
+			return r;
+		}
+		else
+			return pbkMultiplyBintNew(c, b, a);
+	}
+	else
+	{
+		register int r;
+		register _ib fa, fb;
+
+		fa = GETFLAG(a);
+		fb = GETFLAG(b);
+
+		SETFLAG(a, GETABS(GETFLAG(a)));
+		SETFLAG(b, GETABS(GETFLAG(b)));
+
+		r = pbkMultiplyBintNew(c, a, b);
+
+		SETFLAG(a, fa);
+		SETFLAG(b, fb);
+
+		if (r)
+		{
+			if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
+				SETFLAG(c, -GETFLAG(c));
+		}
+
+		return r;
+	}
+}
+
+/* Function name: pbkMultiplyBint
+ * Description:   Multiplies two big integers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big integer.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           c := a * b;
+ *                Schoolbook, Karatsuba, Toom-3 or FFT method is chosen at runtime
+ *                by the sizes of a and b. Thresholds are stored in gTuneTable.
+ */
+bool pbkMultiplyBint(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	else
+	{
+		register size_t la = GETABS(GETFLAG(a)), lb = GETABS(GETFLAG(b));
+		register _ib sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+
+		if (!pbkReallocBint(c, (_ub)(la + lb), true))
+			return false;
+
+		if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
+		{
+			SETFLAG(c, 1);
+			c->data[0] = 0;
+			return true;
+		}
+
+		if (a == b ? !pbbSquare(c->data, a->data, la) : !pbbMultiply(c->data, a->data, la, b->data, lb))
+			return false;
+
+		SETFLAG(c, (_ib)(la + lb));
+		pbkShrinkZeroFlag(c);
+		SETFLAG(c, GETFLAG(c) * sign);
+		return true;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkPadBint
+ * Description:   Copy the low blocks of a big integer and pad it with zeros.
+ * Parameters:
+ *          p Pointer to n blocks to store the result.
+ *          a Pointer to a big integer.
+ *          n Number of blocks.
+ * Return value:  p.
+ */
+static _ub * _pbkPadBint(_ub * p, P_BINT a, size_t n)
+{
+	register size_t la = GETABS(GETFLAG(a));
+	if (la >= n)
+		memcpy(p, a->data, n * sizeof(_ub));
+	else
+	{
+		memcpy(p, a->data, la * sizeof(_ub));
+		memset(p + la, 0, (n - la) * sizeof(_ub));
+	}
+	return p;
+}
+
+/* Function name: pbkMulLowBint
+ * Description:   Multiplies two big integers and keeps the low blocks of the product.
+ * Parameters:
+ *          c Pointer to a big integer to store the result.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ *     blocks Number of blocks to keep. blocks > 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ * Tip:           |c| := |a| * |b| mod B ^ blocks; B = 2 ^ UB_BIT;
+ *                The sign of c is the sign of a * b.
+ *                Montgomery reduction and Newton iterations need only these blocks.
+ */
+bool pbkMulLowBint(P_BINT c, P_BINT a, P_BINT b, _ub blocks)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || 0 == blocks)
+		return false;
+	else
+	{
+		register size_t la = GETABS(GETFLAG(a)), lb = GETABS(GETFLAG(b));
+		register _ib sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+		_ub * p;
+
+		if (la + lb <= blocks) /* Nothing to cut. */
+			return pbkMultiplyBint(c, a, b);
+
+		if (!pbkReallocBint(c, blocks, true))
+			return false;
+		if (NULL == (p = (_ub *)malloc(2 * blocks * sizeof(_ub))))
+			return false;
+
+		if (!pbbMulLow(c->data, _pbkPadBint(p, a, blocks), _pbkPadBint(p + blocks, b, blocks), blocks))
+		{
+			free(p);
+			return false;
+		}
+		free(p);
+
+		SETFLAG(c, (_ib)blocks);
+		pbkShrinkZeroFlag(c);
+		if (!pbkIsBintEqualToZero(c))
+			SETFLAG(c, GETFLAG(c) * sign);
+		return true;
+	}
+}
+
+/* Function name: pbkMulHighBint
+ * Description:   Multiplies two big integers and keeps the high half of the product.
+ * Parameters:
+ *          c Pointer to a big integer to store the result.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ *                The result is an approximation. Let n be the greater length of a and b.
+ *                floor(|a| * |b| / B ^ n) - 2 * n < |c| <= floor(|a| * |b| / B ^ n); B = 2 ^ UB_BIT;
+ * Tip:           The sign of c is the sign of a * b.
+ *                Barrett reduction and Newton division need only these blocks.
+ */
+bool pbkMulHighBint(P_BINT c, P_BINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	else
+	{
+		register size_t la = GETABS(GETFLAG(a)), lb = GETABS(GETFLAG(b)), n = GETMAX(la, lb);
+		register _ib sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+		_ub * p;
+
+		if (!pbkReallocBint(c, (_ub)n, true))
+			return false;
+		if (NULL == (p = (_ub *)malloc(2 * n * sizeof(_ub))))
+			return false;
+
+		if (!pbbMulHigh(c->data, _pbkPadBint(p, a, n), _pbkPadBint(p + n, b, n), n))
+		{
+			free(p);
+			return false;
+		}
+		free(p);
+
+		SETFLAG(c, (_ib)n);
+		pbkShrinkZeroFlag(c);
+		if (!pbkIsBintEqualToZero(c))
+			SETFLAG(c, GETFLAG(c) * sign);
+		return true;
+	}
+}
+
+/* Function name: pbkDivideBint
+ * Description:   Divides two big integers and stores quotient to q and stores reminder to r.
+ * Parameters:
+ *          q Pointer to a big integer that is the quotient. This value can be NULL.
+ *          r Pointer to a big integer that is the reminder. This value can be NULL.
+ *          a Pointer to a big integer that is the numerator.
+ *          b Pointer to a big integer that is the denominator.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of q shall not equal to r.
+ * Tip:           q := a / b; r := a mod b;
+ *                Parameter q or r can be NULL.
+ *                Knuth's Algorithm D, Burnikel-Ziegler or Newton division is chosen
+ *                by the sizes of b and q and thresholds in gTuneTable, see pbbDivide.
+ */
+bool pbkDivideBint(P_BINT q, P_BINT r, P_BINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	else
+	{
+		if (GETFLAG(a) > 0 && GETFLAG(b) > 0) /* +10 / +1. */
+		{
+			if (pbkIsBintEqualToZero(b)) /* 1 / 0 = NaN. */
+				return false;
+
+			if (pbkIsBintEqualToZero(a)) /* 0 / 1 = 0...0 */
+			{
+				if (NULL != q)
+					if (!pbkIbToBint(q, 0))
+						return false;
+				if (NULL != r)
+					if (!pbkIbToBint(r, 0))
+						return false;
+				return true;
+			}
+
+			if (pbkCompareBint(a, b) < 0)
+			{
+				if (NULL != r)
+					if (!pbkMoveBint(r, a))
+						return false;
+				if (NULL != q)
+					if (!pbkIbToBint(q, 0))
+						return false;
+				return true;
+			}
+			else
+			{
+				register size_t la = GETFLAG(a), lb = GETFLAG(b);
+
+				if (NULL != q && !pbkReallocBint(q, (_ub)(la - lb + 1), true))
+					return false;
+				if (NULL != r && !pbkReallocBint(r, (_ub)lb, true))
+					return false;
+
+				if (!pbbDivide(NULL != q ? q->data : NULL, NULL != r ? r->data : NULL, a->data, la, b->data, lb))
+					return false;
+
+				if (NULL != q)
+				{
+					SETFLAG(q, (_ib)(la - lb + 1));
+					pbkShrinkZeroFlag(q);
+				}
+				if (NULL != r)
+				{
+					SETFLAG(r, (_ib)lb);
+					pbkShrinkZeroFlag(r);
+				}
+				return true;
+			}
+		}
+		else
+		{
+			register int rtn = false;
+			register _ib fa, fb;
+
+			fa = GETFLAG(a);
+			fb = GETFLAG(b);
+
+			SETFLAG(a, GETABS(GETFLAG(a)));
+			SETFLAG(b, GETABS(GETFLAG(b)));
+
+			rtn = pbkDivideBint(q, r, a, b);
+
+			SETFLAG(a, fa);
+			SETFLAG(b, fb);
+
+			if (rtn)
+			{
+				if (GETFLAG(a) > 0 || GETFLAG(b) > 0)
+				{
+					if (NULL != q)
+						SETFLAG(q, -GETFLAG(q));
+					if (NULL != r)
+						SETFLAG(r, -GETFLAG(r));
+				}
+			}
+
+			return rtn;
+		}
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkPowerOfTwoBint
+ * Description:   Tests whether the absolute value of a big integer is a power of 2.
+ * Parameters:
+ *          b Pointer to a big integer.
+ *         pk Pointer to a size_t to store k where |b| = 2 ^ k.
+ * Return value:  true:  |b| is a power of 2.
+ *                false: |b| is not.
+ */
+static bool _pbkPowerOfTwoBint(P_BINT b, size_t * pk)
+{
+	register size_t i, lb = GETABS(GETFLAG(b));
+	register _ub d = b->data[lb - 1];
+
+	if (0 == d || 0 != (d & (d - 1)))
+		return false;
+	for (i = 0; i + 1 < lb; ++i)
+		if (0 != b->data[i])
+			return false;
+	for (*pk = (lb - 1) * UB_BIT; d > 1; d >>= 1)
+		++*pk;
+	return true;
+}
+
+/* Function name: pbkModBint
+ * Description:   Computes the reminder of two big integers without the quotient.
+ * Parameters:
+ *          r Pointer to a big integer that is the reminder.
+ *          a Pointer to a big integer that is the numerator.
+ *          b Pointer to a big integer that is the denominator.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of r shall not equal to b.
+ * Tip:           r := a mod b; r may equal to a.
+ *                The result is the same as pbkDivideBint(NULL, r, a, b), but only the
+ *                storage of the reminder is touched. A divisor of 2 ^ k costs one copy.
+ */
+bool pbkModBint(P_BINT r, P_BINT a, P_BINT b)
+{
+	register size_t la, lb;
+	register _ib sign;
+	size_t k;
+
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsBintEqualToZero(b))
+		return false;
+
+	la = GETABS(GETFLAG(a));
+	lb = GETABS(GETFLAG(b));
+	sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+
+	if (_pbkPowerOfTwoBint(b, &k))
+	{
+		lb = k / UB_BIT + 1;
+		if (la < lb)
+		{
+			if (!pbkMoveBint(r, a))
+				return false;
+		}
+		else
+		{
+			if (!pbkReallocBint(r, (_ub)lb, true))
+				return false;
+			memmove(r->data, a->data, lb * sizeof(_ub));
+			r->data[lb - 1] &= ((_ub)1 << (k % UB_BIT)) - 1;
+			SETFLAG(r, (_ib)lb);
+			pbkShrinkZeroFlag(r);
+		}
+	}
+	else if (la < lb)
+	{
+		if (!pbkMoveBint(r, a))
+			return false;
+	}
+	else
+	{
+		if (!pbkReallocBint(r, (_ub)lb, true))
+			return false;
+		if (!pbbDivide(NULL, r->data, a->data, la, b->data, lb))
+			return false;
+		SETFLAG(r, (_ib)lb);
+		pbkShrinkZeroFlag(r);
+	}
+
+	SETFLAG(r, GETABS(GETFLAG(r)));
+	if (!pbkIsBintEqualToZero(r))
+		SETFLAG(r, GETFLAG(r) * sign);
+	return true;
+}
+
+/* Function name: pbkDivBint
+ * Description:   Computes the quotient of two big integers without the reminder.
+ * Parameters:
+ *          q Pointer to a big integer that is the quotient.
+ *          a Pointer to a big integer that is the numerator.
+ *          b Pointer to a big integer that is the denominator.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of q shall not equal to b.
+ * Tip:           q := a / b; q may equal to a.
+ *                The result is the same as pbkDivideBint(q, NULL, a, b), but only the
+ *                storage of the quotient is touched. A divisor of 2 ^ k costs one shift.
+ */
+bool pbkDivBint(P_BINT q, P_BINT a, P_BINT b)
+{
+	register size_t la, lb;
+	register _ib sign;
+	size_t k;
+
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsBintEqualToZero(b))
+		return false;
+
+	la = GETABS(GETFLAG(a));
+	lb = GETABS(GETFLAG(b));
+	sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+
+	if (la < lb)
+		return pbkIbToBint(q, 0);
+
+	if (_pbkPowerOfTwoBint(b, &k))
+	{
+		la -= lb - 1;
+		if (!pbkReallocBint(q, (_ub)la, true))
+			return false;
+		if (0 == k % UB_BIT)
+			memmove(q->data, a->data + lb - 1, la * sizeof(_ub));
+		else
+			pbbRightShift(q->data, a->data + lb - 1, la, (_ub)(k % UB_BIT));
+		SETFLAG(q, (_ib)la);
+	}
+	else
+	{
+		if (!pbkReallocBint(q, (_ub)(la - lb + 1), true))
+			return false;
+		if (!pbbDivide(q->data, NULL, a->data, la, b->data, lb))
+			return false;
+		SETFLAG(q, (_ib)(la - lb + 1));
+	}
+
+	pbkShrinkZeroFlag(q);
+	if (!pbkIsBintEqualToZero(q))
+		SETFLAG(q, GETFLAG(q) * sign);
+	return true;
+}
+
+/* Function name: pbkDivideExactBint
+ * Description:   Divides two big integers when the remainder is known to be 0.
+ * Parameters:
+ *          q Pointer to a big integer that is the quotient.
+ *          a Pointer to a big integer that is the numerator.
+ *          b Pointer to a big integer that is the denominator.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       b shall divide a, otherwise q is garbage.
+ *                The address of q shall not equal to b.
+ * Tip:           q := a / b; q may equal to a.
+ *                This is faster than pbkDivideBint, see pbbDivideExact.
+ */
+bool pbkDivideExactBint(P_BINT q, P_BINT a, P_BINT b)
+{
+	register size_t la, lb;
+	register bool bneg;
+
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsBintEqualToZero(b))
+		return false;
+
+	la = GETABS(GETFLAG(a));
+	lb = GETABS(GETFLAG(b));
+	if (pbkIsBintEqualToZero(a) || la < lb)
+		return pbkIbToBint(q, 0);
+
+	bneg = (GETFLAG(a) < 0) != (GETFLAG(b) < 0);
+	if (!pbkReallocBint(q, (_ub)(la - lb + 1), true))
+		return false;
+	if (!pbbDivideExact(q->data, a->data, la, b->data, lb))
+		return false;
+
+	SETFLAG(q, (_ib)(la - lb + 1));
+	pbkShrinkZeroFlag(q);
+	if (bneg && !pbkIsBintEqualToZero(q))
+		SETFLAG(q, -GETFLAG(q));
+	return true;
+}
+
+/* This section of current C file is for big numbers. */
+#define PBK_POW_MAX (sizeof(size_t) * CHAR_BIT) /* Capacity of a power table. */
+#define PBK_SWAR(b) (0x0101010101010101ULL * (unsigned char)(b)) /* Byte b in each byte of a uint64_t. */
+#define PBK_BITS_WIN 4096U /* Digits of a base of power of 2 sliced at a time. */
+#define PBK_POW_PRIME 4294967291U /* A prime below 2 ^ 32 to check loaded powers. */
+#define PBK_CHECK_PAR 1048576U /* Characters from which validation is split on the worker pool. */
+
+/* BNUM_CHUNK_BASE and BNUM_CHUNK_DIGS are defined for blocks of 32 or 64 bits. Fail to compile otherwise. */
+typedef char PBK_CHUNK_CHECK[4U == sizeof(_ub) || 8U == sizeof(_ub) ? 1 : -1];
+
+/* Powers of a chunk radix for divide and conquer radix conversion. */
+typedef struct st_PBKPOW
+{
+	_ub     b;              /* Base of digits. */
+	_ub     r;              /* Chunk radix. r = b ^ d. */
+	size_t  d;              /* Digits of a chunk. */
+	PBBINV1 ir;             /* Reciprocal of r. */
+	size_t  k;              /* Number of powers. Stored by PBK_STORE and loaded by PBK_LOAD. */
+	size_t  n[PBK_POW_MAX]; /* Blocks of each power. */
+	_ub *   p[PBK_POW_MAX]; /* p[i] = r ^ (2 ^ i). */
+	PBBINVN i[PBK_POW_MAX]; /* Reciprocals of p[i]. i[j].x is NULL if p[j] has none. */
+} PBKPOW, * P_PBKPOW;
+
+/* Power tables of each base. They grow on demand and live until pbkFreePowers. */
+static PBKPOW _pbkPowCache[37];
+
+/* A subtree of printing by divide and conquer that can run on the worker pool. */
+typedef struct st_PBKOUTJOB
+{
+	PBPTASK   task;
+	char *    d;   /* Output of digits. */
+	ptrdiff_t o;   /* Offset of the digits of the subtree in d. */
+	_ub *     a;   /* Blocks to print. */
+	size_t    n;   /* Number of blocks of a. */
+	P_PBKPOW  pw;  /* Power table. */
+	size_t    k;   /* Index of the power to split a at. */
+	bool      bok;
+} PBKOUTJOB, * P_PBKOUTJOB;
+
+/* A subtree of parsing by divide and conquer that can run on the worker pool. */
+typedef struct st_PBKINJOB
+{
+	PBPTASK      task;
+	_ub *        x;  /* Blocks of the result. */
+	size_t       n;  /* Number of blocks of x. */
+	const char * s;  /* Digits to parse. */
+	size_t       nd; /* Number of digits. */
+	P_PBKPOW     pw; /* Power table. */
+	bool         bok;
+} PBKINJOB, * P_PBKINJOB;
+
+/* A range of characters validated on the worker pool. */
+typedef struct st_PBKCHKJOB
+{
+	PBPTASK      task;
+	const char * s;    /* Characters. */
+	size_t       n;    /* Number of characters. */
+	_ub          base; /* Base of digits. */
+	bool         bok;
+} PBKCHKJOB, * P_PBKCHKJOB;
+
+/* Output of radix conversion. Digits are gathered in a buffer that a callback flushes. */
+typedef struct st_PBKSINK
+{
+	CBF_PBKWRITE cbf;   /* Callback to flush buf. NULL: buf is large enough for all digits. */
+	void *       param; /* Parameter of cbf. */
+	char *       buf;   /* Buffer of characters. */
+	size_t       size;  /* Capacity of buf. */
+	size_t       used;  /* Characters in buf. */
+	char *       tmp;   /* Digits of a leaf of conversion. */
+	bool         blead; /* true: Leading zeros are dropped. */
+} PBKSINK, * P_PBKSINK;
+
+/* A caller buffer that takes the head of the digits and counts all of them. */
+typedef struct st_PBKBOUND
+{
+	char * str;  /* Buffer of the caller. */
+	size_t size; /* Capacity of str including the terminating zero. */
+	size_t n;    /* Characters written so far, including those cut off. */
+} PBKBOUND, * P_PBKBOUND;
+
+static void   _pbkInitPowers     (P_PBKPOW pw, _ub base);
+static bool   _pbkPushPower      (P_PBKPOW pw, _ub * p, size_t n, bool bx);
+static bool   _pbkGrowPowers     (P_PBKPOW pw, _ub base, size_t k);
+static P_PBKPOW _pbkGetPowers    (_ub base, size_t k);
+static _ub    _pbkResidue        (const _ub * a, size_t n);
+static _ub    _pbkDigitValue     (char c);
+static _ub    _pbkPowerOfTwoBase (_ub base);
+static uint64_t _pbkLoad8        (const char * s);
+static bool   _pbkIsDigitsSz     (const char * s, size_t n, _ub base);
+static bool   _pbkIsDigitsPar    (const char * s, size_t n, _ub base, P_PBPWORKER wk);
+static void   _pbkCheckTask      (void * arg, P_PBPWORKER wk);
+static _ub    _pbkParse8         (const char * s);
+static _ub    _pbkParseChunk     (const char * s);
+static void   _pbkFormatChunk    (char * d, _ub r);
+static bool   _pbkDigitsToBlocks (_ub * x, size_t * pn, const char * s, size_t nd, P_PBKPOW pw, P_PBPWORKER wk);
+static void   _pbkDigitsTask     (void * arg, P_PBPWORKER wk);
+static void   _pbkDigitsToBits   (_ub * x, size_t * pn, const char * s, size_t nd, _ub b);
+static bool   _pbkDigitsToBint   (P_BINT x, const char * s, size_t nd, _ub base);
+static void   _pbkBitsToDigits   (char * d, size_t nd, const _ub * a, size_t n, _ub b, size_t o);
+static void   _pbkChunksToDigits (char * d, size_t nd, _ub * a, size_t n, P_PBKPOW pw);
+static bool   _pbkSinkWrite      (P_PBKSINK ps, const char * s, size_t n);
+static bool   _pbkLeafToSink     (P_PBKSINK ps, _ub * a, size_t n, P_PBKPOW pw, size_t nd);
+static bool   _pbkBlocksToSink   (P_PBKSINK ps, _ub * a, size_t n, P_PBKPOW pw, size_t k);
+static void   _pbkZerosToBuffer  (char * d, ptrdiff_t o, size_t nd);
+static bool   _pbkLeafToBuffer   (char * d, ptrdiff_t o, size_t nd, _ub * a, size_t n, P_PBKPOW pw);
+static bool   _pbkBlocksToBuffer (char * d, ptrdiff_t o, _ub * a, size_t n, P_PBKPOW pw, size_t k, P_PBPWORKER wk);
+static void   _pbkBlocksTask     (void * arg, P_PBPWORKER wk);
+static size_t _pbkBintToBuffer   (char * s, P_BINT a, _ub base, size_t l);
+static bool   _pbkBintToSink     (P_PBKSINK ps, P_BINT a, _ub base);
+static char * _pbkBintToDigits   (P_BINT a, _ub base, size_t * pn);
+static bool   _pbkWriteBounded   (const char * s, size_t n, void * param);
+static bool   _pbkPowerOfBase    (_ub * p, size_t * pn, _ub base, size_t e);
+static _ub    _pbkBnumRadix      (_ub base, _ub * pk);
+static _udb   _pbkDivLimb        (_udb t, _ub r);
+static void   _pbkFormatLimb     (char * d, _ub x, _ub base, _ub k);
+static size_t _pbkDigitsToLimbs  (_ub * x, const char * s, size_t nd, _ub base, _ub k);
+static int    _pbkCompareLimbs   (const _ub * a, size_t la, const _ub * b, size_t lb);
+static _ub    _pbkAddLimbs       (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r);
+static _ub    _pbkSubtractLimbs  (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r);
+static _ub    _pbkMulLimbs1      (_ub * c, const _ub * a, size_t n, _ub b, _ub r);
+static _ub    _pbkAddMulLimbs1   (_ub * c, const _ub * a, size_t n, _ub b, _ub r);
+static void   _pbkMulLimbsBasecase (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r);
+static size_t _pbkLimbsItch      (size_t n);
+static bool   _pbkAbsDiffLimbs   (_ub * d, const _ub * a, size_t m, size_t h, _ub r);
+static void   _pbkMulLimbsKaratsuba(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws, _ub r);
+static bool   _pbkMulLimbs       (_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r);
+static bool   _pbkAddSubtractBnum(P_BNUM c, P_BNUM a, P_BNUM b, bool bsub);
+
+/* Function name: pbkInitBnum
+ * Description:   Initialize a big number.
+ * Parameters:
+ *        pbn Pointer to a big number.
+ *       base Base value of the big number. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Big number structure shall be initialized to 0.
+ * Tip:           This function is used only to initialize big numbers,
+ *                but not for change the value or capacity for any big number.
+ *                A limb of a big number holds the most digits of base that fit in a block,
+ *                that is BNUM_CHUNK_DIGS digits for base 10.
+ */
+bool pbkInitBnum(P_BNUM pbn, _ub base)
+{
+	if (NULL == pbn->data && base >= 2 && base <= 36)
+	{
+		SETFLAG(pbn, 1);
+		SETSIZE(pbn, BNUM_INIT_SIZE);
+		SETINCL(pbn, BNUM_INIT_INCL);
+		SETBASE(pbn, base);
+		pbn->data = (_ub *)malloc((GETSIZE(pbn) + GETINCL(pbn)) * sizeof(_ub));
+		if (NULL == pbn->data)
+		{
+			SETFLAG(pbn, 0);
+			SETSIZE(pbn, 0U);
+		}
+		else
+		{
+			pbn->data[0] = 0;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Function name: pbkReallocBnum
+ * Description:   Reallocate a big number.
+ * Parameters:
+ *        pbi Pointer to a big number.
+ *       size New size of capacity to big number in limbs.
+ *       binc Increase the capacity or decrease it.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           This function can be used to initialize big numbers.
+ */
+bool pbkReallocBnum(P_BNUM pbn, _ub size, bool binc)
+{
+	if (!binc && (GETSIZE(pbn) == size))
+	{
+		return true;
+	}
+	else if (binc && (GETSIZE(pbn) >= size))
+	{
+		return true;
+	}
+	else
+	{
+		_ub * pnew = (_ub *)realloc(pbn->data, SETSIZE(pbn, (binc ? size + GETINCL(pbn) : size)) * sizeof(_ub));
+		if (NULL != pnew)
+		{
+			pbn->data = pnew;
+			return true;
+		}
+		else
+		{
+			SETFLAG(pbn, 0);
+			SETSIZE(pbn, 0U);
+			pbn->data = NULL;
+			return false;
+		}
+	}
+}
+
+/* Function name: pbkFreeBnum
+ * Description:   Initialize a big number.
+ * Parameter:
+ *       pbi Pointer to a big number.
+ * Return value:  N/A.
+ */
+void pbkFreeBnum(P_BNUM pbn)
+{
+	if (pbn->data)
+		free(pbn->data);
+	pbn->data = NULL;
+	SETFLAG(pbn, 0);
+	SETSIZE(pbn, 0U);
+}
+
+/* Function name: pbkCreateBnum
+ * Description:   Create a big number in main memory.
+ * Parameter:
+ *      base Base value you want to set to big number.
+ * Return value:  Pointer to new created big number structure.
+ */
+P_BNUM pbkCreateBnum(_ub base)
+{
+	register P_BNUM pbn = malloc(sizeof(BNUM));
+	if (NULL != pbn)
+	{
+		memset(pbn, 0, sizeof(BNUM));
+		if (!pbkInitBnum(pbn, base))
+		{
+			free(pbn);
+			pbn = NULL;
+		}
+	}
+	return pbn;
+}
+
+/* Function name: pbkDeleteBnum
+ * Description:   Deallocate a big number from main memory.
+ * Parameter:
+ *       pbi Pointer to a big number.
+ * Return value:  N/A.
+ */
+void pbkDeleteBnum(P_BNUM pbn)
+{
+	pbkFreeBnum(pbn);
+	free(pbn);
+}
+
+/* Function name: pbkMoveBnum
+ * Description:   Move the memory of a big number to another big number.
+ * Parameters:
+ *         a Pointer to a big number.
+ *         b Pointer to another big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Parameter a and b shall not be NULL.
+ * Tip:           After invoking, the capacity of a will equal to b's.
+ */
+bool pbkMoveBnum(P_BNUM a, P_BNUM b)
+{
+	if (pbkReallocBnum(a, GETSIZE(b), true))
+	{
+		memmove(a->data, b->data, GETABS(GETFLAG(b)) * sizeof(_ub));
+		SETFLAG(a, GETFLAG(b));
+		SETBASE(a, GETBASE(b));
+		return true;
+	}
+	return false;
+}
+
+/* Function name: pbkIbToBnum
+ * Description:   Convert an integer to big number.
+ * Parameters:
+ *        pbn Pointer to a big number.
+ *          n Value you want to set to the big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           This function will not change pbn's capacity.
+ *                Limbs are split off with a precomputed reciprocal of the limb radix.
+ */
+bool pbkIbToBnum(P_BNUM pbn, _ib n)
+{
+	register _ib sign = GETSGN(n);
+	_ub u, k;
+	PBBINV1 inv;
+	if (pbkIsNotANumber(pbn))
+		return false;
+	if (n == 0)
+	{
+		SETFLAG(pbn, 1);
+		pbn->data[0] = 0;
+		return true;
+	}
+
+	u = (_ub)GETABS(n);
+	pbbInvert1(&inv, _pbkBnumRadix(GETBASE(pbn), &k));
+
+	for (SETFLAG(pbn, 0); u > 0;)
+	{
+		if (GETFLAG(pbn) + 1 >= (_ib)GETSIZE(pbn))
+		{
+			if (!pbkReallocBnum(pbn, GETSIZE(pbn), true))
+				return false;
+		}
+
+		pbn->data[GETFLAG(pbn)++] = pbbDivide1Inv(&u, &u, 1, &inv);
+	}
+
+	SETFLAG(pbn, GETFLAG(pbn) * sign);
+
+	return true;
+}
+
+/* Function name: pbkDecimalSzToBnum
+ * Description:   Convert a base 10 presented string to big number.
+ * Parameters:
+ *        pbn Pointer to a big number.
+ *        str Pointer to a string.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       This string shall contain ASCII number 0-9. And Shall not contain minus sign(-).
+ * Tip:           The base of pbn becomes 10. Each limb takes BNUM_CHUNK_DIGS digits.
+ */
+bool pbkDecimalSzToBnum(P_BNUM pbn, const char * str)
+{
+	register size_t j = strlen(str);
+	if (0 == j || !_pbkIsDigitsSz(str, j, 10))
+		return false;
+	if (pbkReallocBnum(pbn, (_ub)((j + BNUM_CHUNK_DIGS - 1) / BNUM_CHUNK_DIGS), true))
+	{
+		SETBASE(pbn, 10);
+		SETFLAG(pbn, (_ib)_pbkDigitsToLimbs(pbn->data, str, j, 10, BNUM_CHUNK_DIGS));
+		pbkShrinkZeroFlag(pbn);
+		return true;
+	}
+	return false;
+}
+
+/* Function name: pbkPrintBnum
+ * Description:   Print a big number.
+ * Parameter:
+ *       pbn Pointer to a big number.
+ * Return value:  N/A.
+ */
+void pbkPrintBnum(P_BNUM pbn)
+{
+	if (pbkIsNotANumber(pbn))
+	{
+		printf("NaN");
+		return;
+	}
+	else
+	{
+		register size_t i, j;
+		_ub k;
+		char d[UB_BIT];
+
+		_pbkBnumRadix(GETBASE(pbn), &k);
+		if (GETFLAG(pbn) < 0)
+			putchar('-');
+		for (i = GETABS(GETFLAG(pbn)); i > 0; --i)
+		{
+			_pbkFormatLimb(d, pbn->data[i - 1], GETBASE(pbn), k);
+			/* Leading zeros of the highest limb are not printed. */
+			for (j = 0; i == (size_t)GETABS(GETFLAG(pbn)) && j + 1 < k && '0' == d[j]; ++j)
+				;
+			fwrite(d + j, 1, k - j, stdout);
+		}
+	}
+}
+
+/* Function name: pbkAddBnum
+ * Description:   Adds two big numbers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big number.
+ *          a Pointer to a big number.
+ *          b Pointer to a big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       a and b shall have the same base.
+ * Tip:           c := a + b; The address of c can equal to a or b.
+ *                Limbs are added in their own radix, so decimal sums need no radix conversion.
+ */
+bool pbkAddBnum(P_BNUM c, P_BNUM a, P_BNUM b)
+{
+	return _pbkAddSubtractBnum(c, a, b, false);
+}
+
+/* Function name: pbkSubtractBnum
+ * Description:   Subtracts two big numbers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big number.
+ *          a Pointer to a big number.
+ *          b Pointer to a big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       a and b shall have the same base.
+ * Tip:           c := a - b; The address of c can equal to a or b.
+ */
+bool pbkSubtractBnum(P_BNUM c, P_BNUM a, P_BNUM b)
+{
+	return _pbkAddSubtractBnum(c, a, b, true);
+}
+
+/* Function name: pbkMultiplyBnum1
+ * Description:   Multiplies a big number by a block and stores result to c.
+ * Parameters:
+ *          c Pointer to a big number.
+ *          a Pointer to a big number.
+ *          b A block.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           c := a * b; The address of c can equal to a.
+ *                Each limb costs one multiplication and one division by a constant radix.
+ */
+bool pbkMultiplyBnum1(P_BNUM c, P_BNUM a, _ub b)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	else
+	{
+		register size_t n = GETABS(GETFLAG(a));
+		register _ib sign = GETSGN(GETFLAG(a));
+		register _ub r, k;
+		_ub d;
+
+		r = _pbkBnumRadix(GETBASE(a), &d);
+		/* The carry is less than a block, so it takes at most two limbs. */
+		if (!pbkReallocBnum(c, (_ub)(n + 2), true))
+			return false;
+
+		k = _pbkMulLimbs1(c->data, a->data, n, b, r);
+		for (; k > 0; k /= r)
+			c->data[n++] = k % r;
+
+		SETBASE(c, GETBASE(a));
+		SETFLAG(c, (_ib)n);
+		pbkShrinkZeroFlag(c);
+		if (!pbkIsBintEqualToZero(c))
+			SETFLAG(c, GETFLAG(c) * sign);
+		return true;
+	}
+}
+
+/* Function name: pbkMultiplyBnum
+ * Description:   Multiplies two big numbers and stores result to c.
+ * Parameters:
+ *          c Pointer to a big number.
+ *          a Pointer to a big number.
+ *          b Pointer to a big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The address of c shall not equal to a or b.
+ *                a and b shall have the same base.
+ * Tip:           c := a * b;
+ *                Schoolbook method is used below gTuneTable.mulkara limbs, Karatsuba method above.
+ */
+bool pbkMultiplyBnum(P_BNUM c, P_BNUM a, P_BNUM b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || GETBASE(a) != GETBASE(b))
+		return false;
+	else
+	{
+		register size_t la = GETABS(GETFLAG(a)), lb = GETABS(GETFLAG(b));
+		register _ib sign = (GETFLAG(a) > 0) == (GETFLAG(b) > 0) ? 1 : -1;
+		register bool bok;
+		_ub k;
+
+		if (!pbkReallocBnum(c, (_ub)(la + lb), true))
+			return false;
+		SETBASE(c, GETBASE(a));
+
+		if (pbkIsBintEqualToZero(a) || pbkIsBintEqualToZero(b)) /* 0 * a = 0. */
+		{
+			SETFLAG(c, 1);
+			c->data[0] = 0;
+			return true;
+		}
+
+		if (la >= lb)
+			bok = _pbkMulLimbs(c->data, a->data, la, b->data, lb, _pbkBnumRadix(GETBASE(a), &k));
+		else
+			bok = _pbkMulLimbs(c->data, b->data, lb, a->data, la, _pbkBnumRadix(GETBASE(a), &k));
+		if (!bok)
+			return false;
+
+		SETFLAG(c, (_ib)(la + lb));
+		pbkShrinkZeroFlag(c);
+		SETFLAG(c, GETFLAG(c) * sign);
+		return true;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkInitPowers
+ * Description:   Initializes an empty power table for a base.
+ * Parameters:
+ *         pw Pointer to a power table.
+ *       base Base of digits. 2 - 36.
+ * Return value:  N/A.
+ * Tip:           A chunk is the most digits of base that fit in a block.
+ */
+static void _pbkInitPowers(P_PBKPOW pw, _ub base)
+{
+	_ub d;
+
+	pw->b = base;
+	pw->r = _pbkBnumRadix(base, &d);
+	pw->d = d;
+	pbbInvert1(&pw->ir, pw->r);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkPushPower
+ * Description:   Appends a power to a power table and publishes it.
+ * Parameters:
+ *         pw Pointer to a power table.
+ *          p Pointer to 3 * n + 1 blocks allocated by malloc whose lowest n blocks are the power.
+ *          n Number of blocks of the power.
+ *         bx true:  The reciprocal is in the highest n + 1 blocks of p. It is checked.
+ *            false: The reciprocal is computed from gTuneTable.divnewton blocks.
+ * Return value:  true:  Succeeded. pw owns p.
+ *                false: Failed. p is freed.
+ * Caution:       Call it with the lock of power tables held.
+ */
+static bool _pbkPushPower(P_PBKPOW pw, _ub * p, size_t n, bool bx)
+{
+	register size_t i = pw->k, j;
+	register P_PBBINVN pi = &pw->i[i];
+	register bool bok = true;
+	_ub * t, u, one = 1;
+
+	pi->x = NULL;
+	if (bx)
+	{
+		/* Normalize p and check that 0 <= B ^ (2 * n) - d * x < d. */
+		pi->d = p + n;
+		pi->x = p + 2 * n;
+		pi->n = n;
+		for (pi->s = 0, u = p[n - 1]; !(u & ((_ub)1 << (UB_BIT - 1))); u <<= 1)
+			++pi->s;
+		if (pi->s > 0)
+			pbbLeftShift(pi->d, p, n, pi->s);
+		else
+			memcpy(pi->d, p, n * sizeof(_ub));
+
+		if (NULL == (t = (_ub *)malloc((2 * n + 1) * sizeof(_ub))))
+			bok = false;
+		else
+		{
+			if ((bok = pbbMultiply(t, pi->d, n, pi->x, n + 1)))
+			{
+				if (0 == t[2 * n])
+				{
+					for (j = 0; j < 2 * n; ++j)
+						t[j] = ~t[j];
+					pbbAdd(t, t, 2 * n, &one, 1);
+					for (j = n; bok && j < 2 * n; ++j)
+						bok = 0 == t[j];
+					bok = bok && pbbCompare(t, pi->d, n) < 0;
+				}
+				else
+				{
+					bok = 1 == t[2 * n];
+					for (j = 0; bok && j < 2 * n; ++j)
+						bok = 0 == t[j];
+				}
+			}
+			free(t);
+		}
+	}
+	else if (n > 1 && n >= gTuneTable.divnewton)
+		bok = pbbInvertN(pi, p + n, p, n);
+
+	if (!bok)
+	{
+		pi->x = NULL;
+		free(p);
+		return false;
+	}
+	pw->p[i] = p;
+	pw->n[i] = n;
+	PBK_STORE(pw->k, i + 1);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkGrowPowers
+ * Description:   Computes powers of the chunk radix for radix conversion up to an index.
+ * Parameters:
+ *         pw Pointer to a power table.
+ *       base Base of digits. 2 - 36.
+ *          k Index of the greatest power that is needed.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       Call it with the lock of power tables held.
+ * Tip:           pw->p[i] := pw->r ^ (2 ^ i); Each power is the square of the last.
+ */
+static bool _pbkGrowPowers(P_PBKPOW pw, _ub base, size_t k)
+{
+	register size_t i;
+	_ub * p;
+
+	if (0 == pw->k)
+	{
+		_pbkInitPowers(pw, base);
+		if (NULL == (p = (_ub *)malloc(4 * sizeof(_ub))))
+			return false;
+		p[0] = pw->r;
+		if (!_pbkPushPower(pw, p, 1, false))
+			return false;
+	}
+	for (i = pw->k; i <= k && i < PBK_POW_MAX; ++i)
+	{
+		register size_t n = 2 * pw->n[i - 1];
+
+		if (NULL == (p = (_ub *)malloc((3 * n + 1) * sizeof(_ub))))
+			return false;
+		if (!pbbSquare(p, pw->p[i - 1], pw->n[i - 1]))
+		{
+			free(p);
+			return false;
+		}
+		if (0 == p[n - 1])
+			--n;
+		if (!_pbkPushPower(pw, p, n, false))
+			return false;
+	}
+	return k < pw->k;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkGetPowers
+ * Description:   Gets the shared power table of a base.
+ * Parameters:
+ *       base Base of digits. 2 - 36.
+ *          k Index of the greatest power that is needed.
+ * Return value:  Pointer to the power table that holds p[0] to p[k].
+ *                NULL: Failed.
+ * Tip:           Tables only grow, so a power once published is never changed or moved.
+ *                If the table already holds p[k], no lock is taken.
+ */
+static P_PBKPOW _pbkGetPowers(_ub base, size_t k)
+{
+	register P_PBKPOW pw = &_pbkPowCache[base];
+	register bool bok;
+
+	if (PBK_LOAD(pw->k) > k)
+		return pw;
+	PBK_POW_LOCK();
+	bok = _pbkGrowPowers(pw, base, k);
+	PBK_POW_UNLOCK();
+	return bok ? pw : NULL;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkResidue
+ * Description:   Computes the remainder of a block array divided by PBK_POW_PRIME.
+ * Parameters:
+ *          a Pointer to a block array.
+ *          n Number of blocks.
+ * Return value:  a mod PBK_POW_PRIME.
+ */
+static _ub _pbkResidue(const _ub * a, size_t n)
+{
+	register _udb r = 0;
+
+	while (n > 0)
+		r = ((r << UB_BIT) | a[--n]) % PBK_POW_PRIME;
+	return (_ub)r;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitValue
+ * Description:   Converts an ASCII digit to its value.
+ * Parameter:
+ *          c A character. 0-9, a-z or A-Z.
+ * Return value:  The value of c. 36 if c is not a digit.
+ * Tip:           A table lookup does not branch on mixed digits and letters.
+ */
+static _ub _pbkDigitValue(char c)
+{
+	static const unsigned char tab[256] =
+	{
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 36, 36, 36, 36, 36, 36,
+		36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+		25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+		36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+		25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+		36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36
+	};
+	return tab[(unsigned char)c];
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkPowerOfTwoBase
+ * Description:   Tests whether a base is a power of 2.
+ * Parameter:
+ *       base Base of digits. 2 - 36.
+ * Return value:  b if base = 2 ^ b; 0 otherwise.
+ */
+static _ub _pbkPowerOfTwoBase(_ub base)
+{
+	register _ub b = 0;
+	if (base & (base - 1))
+		return 0;
+	while ((1U << b) < base)
+		++b;
+	return b;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkLoad8
+ * Description:   Loads 8 characters into a 64-bit integer.
+ * Parameter:
+ *          s Pointer to 8 characters.
+ * Return value:  The characters. s[0] is in the lowest byte.
+ * Tip:           Compilers merge the shifts into one load on little endian hosts.
+ */
+static uint64_t _pbkLoad8(const char * s)
+{
+	register const unsigned char * p = (const unsigned char *)s;
+	return (uint64_t)p[0]       | (uint64_t)p[1] << 8  | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+		   (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkIsDigitsSz
+ * Description:   Tests whether characters are all ASCII digits of a base.
+ * Parameters:
+ *          s Pointer to characters.
+ *          n Number of characters.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  All of them are digits of base.
+ *                false: Not all of them.
+ * Tip:           Decimal digits are tested 8 at a time. A byte is a digit if its high nibble is 3
+ *                and adding 6 to it keeps the high nibble 3.
+ */
+static bool _pbkIsDigitsSz(const char * s, size_t n, _ub base)
+{
+	register size_t i = 0;
+	register uint64_t x;
+
+	if (10 == base)
+	{
+		for (; i + 8 <= n; i += 8)
+		{
+			x = _pbkLoad8(s + i);
+			if (((x & PBK_SWAR(0xf0)) | (((x + PBK_SWAR(0x06)) & PBK_SWAR(0xf0)) >> 4)) != PBK_SWAR(0x33))
+				return false;
+		}
+	}
+	for (; i < n; ++i)
+		if (_pbkDigitValue(s[i]) >= base)
+			return false;
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkIsDigitsPar
+ * Description:   Tests whether characters are all ASCII digits of a base on the worker pool.
+ * Parameters:
+ *          s Pointer to characters.
+ *          n Number of characters.
+ *       base Base of digits. 2 - 36.
+ *         wk Pointer to the current worker or NULL to run serially.
+ * Return value:  true:  All of them are digits of base.
+ *                false: Not all of them.
+ * Tip:           From 2 * PBK_CHECK_PAR characters the higher half is forked while
+ *                the lower half is tested. See _pbkIsDigitsSz.
+ */
+static bool _pbkIsDigitsPar(const char * s, size_t n, _ub base, P_PBPWORKER wk)
+{
+	PBKCHKJOB job;
+	bool bok;
+
+	if (NULL == wk || n < 2 * PBK_CHECK_PAR)
+		return _pbkIsDigitsSz(s, n, base);
+
+	job.task.func = _pbkCheckTask;
+	job.task.arg = &job;
+	job.s = s + n / 2;
+	job.n = n - n / 2;
+	job.base = base;
+	pbpFork(wk, &job.task);
+	bok = _pbkIsDigitsPar(s, n / 2, base, wk);
+	pbpJoin(wk, &job.task);
+	return bok && job.bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkCheckTask
+ * Description:   Task callback of validating a range of characters.
+ * Parameters:
+ *        arg Pointer to a PBKCHKJOB.
+ *         wk Pointer to the worker who runs the task.
+ * Return value:  N/A.
+ */
+static void _pbkCheckTask(void * arg, P_PBPWORKER wk)
+{
+	P_PBKCHKJOB pj = (P_PBKCHKJOB)arg;
+	pj->bok = _pbkIsDigitsPar(pj->s, pj->n, pj->base, wk);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkParse8
+ * Description:   Converts 8 ASCII decimal digits to a block.
+ * Parameter:
+ *          s Pointer to 8 digits. The highest digit comes first.
+ * Return value:  The value of the digits.
+ * Tip:           Neighbouring digits, pairs and quads are joined by three multiplications.
+ */
+static _ub _pbkParse8(const char * s)
+{
+	register uint64_t x = _pbkLoad8(s) - PBK_SWAR('0');
+
+	x = (x * 10 + (x >> 8)) & PBK_SWAR(0xff) / 0xffff * 0xff;                  /* 00 ab 00 cd ... */
+	x = (x * 100 + (x >> 16)) & PBK_SWAR(0xff) / 0xffffffff * 0xffff;          /* 0000 abcd ... */
+	return (_ub)((x * 10000 + (x >> 32)) & 0xffffffffU);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkParseChunk
+ * Description:   Converts BNUM_CHUNK_DIGS ASCII decimal digits to a block.
+ * Parameter:
+ *          s Pointer to BNUM_CHUNK_DIGS digits. The highest digit comes first.
+ * Return value:  The value of the digits.
+ * Tip:           The digits above a multiple of 8 are gathered one by one, the rest by _pbkParse8.
+ */
+static _ub _pbkParseChunk(const char * s)
+{
+	register _ub t = 0;
+	register size_t i;
+
+	for (i = 0; i < BNUM_CHUNK_DIGS % 8; ++i)
+		t = t * 10 + (_ub)(s[i] - '0');
+	for (; i < BNUM_CHUNK_DIGS; i += 8)
+		t = t * 100000000U + _pbkParse8(s + i);
+	return t;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkFormatChunk
+ * Description:   Converts a block less than BNUM_CHUNK_BASE to BNUM_CHUNK_DIGS ASCII digits.
+ * Parameters:
+ *          d Pointer to BNUM_CHUNK_DIGS characters. The highest digit comes first.
+ *          r A block less than BNUM_CHUNK_BASE.
+ * Return value:  N/A.
+ * Tip:           Two digits are copied at a time from a table of 00 to 99, the lowest first.
+ */
+static void _pbkFormatChunk(char * d, _ub r)
+{
+	static const char pairs[] =
+		"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+		"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+	register size_t i = BNUM_CHUNK_DIGS;
+
+	for (; i >= 2; i -= 2, r /= 100)
+		memcpy(d + i - 2, pairs + 2 * (r % 100), 2);
+	if (i > 0)
+		d[0] = (char)('0' + r);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitsToBlocks
+ * Description:   Converts digits to a block array by divide and conquer.
+ * Parameters:
+ *          x Pointer to nd / pw->d + 3 blocks to store the result.
+ *         pn Pointer to a size_t to store the number of blocks of x.
+ *          s Pointer to ASCII digits of base pw->b. The highest digit comes first.
+ *         nd Number of digits. nd > 0.
+ *         pw Pointer to a power table that holds every power less than pw->b ^ nd.
+ *         wk Pointer to the current worker or NULL to run serially.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           The digits are split at pw->d * 2 ^ k from the lowest, the greatest
+ *                split below nd, and x := hi * pw->p[k] + lo;
+ *                Below gTuneTable.convdc blocks pw->d digits are gathered into a block
+ *                and added to x multiplied by pw->r in place.
+ *                Decimal chunks are parsed 8 digits at a time.
+ *                With a worker, hi is forked to the pool from gTuneTable.mulpar blocks.
+ */
+static bool _pbkDigitsToBlocks(_ub * x, size_t * pn, const char * s, size_t nd, P_PBKPOW pw, P_PBPWORKER wk)
+{
+	if (nd <= pw->d || nd / pw->d < gTuneTable.convdc)
+	{
+		register size_t i, j, n = 1;
+		_ub t;
+
+		/* The highest chunk takes the odd digits. */
+		j = (nd - 1) % pw->d + 1;
+		for (x[0] = 0, i = 0; i < j; ++i)
+			x[0] = x[0] * pw->b + _pbkDigitValue(s[i]);
+		for (; j < nd; j += pw->d)
+		{
+			if (10 == pw->b)
+				t = _pbkParseChunk(s + j);
+			else
+				for (t = 0, i = j; i < j + pw->d; ++i)
+					t = t * pw->b + _pbkDigitValue(s[i]);
+			x[n] = pbbMultiply1(x, x, n, pw->r);
+			pbbAdd(x, x, n + 1, &t, 1);
+			if (0 != x[n])
+				++n;
+		}
+		*pn = n;
+		return true;
+	}
+	else
+	{
+		register size_t k = 0, l;
+		size_t lh, ll;
+		register bool bok;
+		_ub * w;
+
+		while (k + 1 < PBK_LOAD(pw->k) && (pw->d << (k + 1)) < nd)
+			++k;
+		l = pw->d << k;
+
+		if (NULL == (w = (_ub *)malloc(((nd - l) / pw->d + 3 + l / pw->d + 3) * sizeof(_ub))))
+			return false;
+		if (NULL != wk && nd / pw->d >= gTuneTable.mulpar)
+		{
+			PBKINJOB job;
+
+			job.task.func = _pbkDigitsTask;
+			job.task.arg = &job;
+			job.x = w + l / pw->d + 3;
+			job.s = s;
+			job.nd = nd - l;
+			job.pw = pw;
+			pbpFork(wk, &job.task);
+			bok = _pbkDigitsToBlocks(w, &ll, s + nd - l, l, pw, wk);
+			pbpJoin(wk, &job.task);
+			bok = bok && job.bok;
+			lh = job.n;
+		}
+		else
+			bok = _pbkDigitsToBlocks(w, &ll, s + nd - l, l, pw, NULL) &&
+				_pbkDigitsToBlocks(w + l / pw->d + 3, &lh, s, nd - l, pw, NULL);
+		if (bok)
+		{
+			register _ub * h = w + l / pw->d + 3;
+			register size_t n = lh + pw->n[k];
+
+			if ((bok = pbbMultiply(x, h, lh, pw->p[k], pw->n[k])))
+			{
+				pbbAdd(x, x, n, w, ll);
+				while (n > 1 && 0 == x[n - 1])
+					--n;
+				*pn = n;
+			}
+		}
+		free(w);
+		return bok;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitsTask
+ * Description:   Task callback of parsing a subtree of digits.
+ * Parameters:
+ *        arg Pointer to a PBKINJOB.
+ *         wk Pointer to the worker who runs the task.
+ * Return value:  N/A.
+ */
+static void _pbkDigitsTask(void * arg, P_PBPWORKER wk)
+{
+	P_PBKINJOB pj = (P_PBKINJOB)arg;
+	pj->bok = _pbkDigitsToBlocks(pj->x, &pj->n, pj->s, pj->nd, pj->pw, wk);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitsToBits
+ * Description:   Converts digits of base 2 ^ b to a block array.
+ * Parameters:
+ *          x Pointer to nd * b / UB_BIT + 1 blocks to store the result.
+ *         pn Pointer to a size_t to store the number of blocks of x.
+ *          s Pointer to ASCII digits. The highest digit comes first.
+ *         nd Number of digits. nd > 0.
+ *          b Bits of a digit.
+ * Return value:  N/A.
+ * Tip:           Each digit is shifted into place from the lowest, so no multiplication is done.
+ */
+static void _pbkDigitsToBits(_ub * x, size_t * pn, const char * s, size_t nd, _ub b)
+{
+	register size_t n = 0;
+	register _udb w = 0;
+	register _ub l = 0;
+
+	while (nd > 0)
+	{
+		w |= (_udb)_pbkDigitValue(s[--nd]) << l;
+		if ((l += b) >= UB_BIT)
+		{
+			x[n++] = (_ub)w;
+			w >>= UB_BIT;
+			l -= UB_BIT;
+		}
+	}
+	if (l > 0 || 0 == n)
+		x[n++] = (_ub)w;
+	*pn = n;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitsToBint
+ * Description:   Converts digits to a non-negative big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *          s Pointer to ASCII digits of base. The highest digit comes first.
+ *         nd Number of digits. nd > 0.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Digits of a base of power of 2 are sliced into bits in linear time.
+ *                If pbpStartPool has been called, digits of gTuneTable.mulpar blocks or more
+ *                are parsed by all workers.
+ */
+static bool _pbkDigitsToBint(P_BINT x, const char * s, size_t nd, _ub base)
+{
+	register size_t k = 0;
+	register bool bok;
+	P_PBKPOW pw;
+	P_PBPWORKER wk;
+	size_t n;
+	_ub d;
+
+	_pbkBnumRadix(base, &d);
+	if (!pbkReallocBint(x, (_ub)(nd / d + 3), true))
+		return false;
+	if (_pbkPowerOfTwoBase(base) > 0)
+		_pbkDigitsToBits(x->data, &n, s, nd, _pbkPowerOfTwoBase(base));
+	else
+	{
+		if (nd / d >= gTuneTable.convdc)
+			while ((d << (k + 1)) < nd)
+				++k;
+		if (NULL == (pw = _pbkGetPowers(base, k)))
+			return false;
+		wk = nd / d >= gTuneTable.mulpar ? pbpEnter() : NULL;
+		bok = _pbkDigitsToBlocks(x->data, &n, s, nd, pw, wk);
+		if (NULL != wk)
+			pbpLeave(wk);
+		if (!bok)
+			return false;
+	}
+
+	SETFLAG(x, (_ib)n);
+	pbkShrinkZeroFlag(x);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBitsToDigits
+ * Description:   Converts bits of a block array to digits of base 2 ^ b.
+ * Parameters:
+ *          d Pointer to nd characters. The highest digit comes first.
+ *         nd Number of digits to write.
+ *          a Pointer to a block array.
+ *          n Number of blocks of a. n > 0.
+ *          b Bits of a digit.
+ *          o Offset of the bit where the lowest digit begins.
+ * Return value:  N/A.
+ * Tip:           b bits are sliced off at a time from the lowest. Bits above a give 0.
+ */
+static void _pbkBitsToDigits(char * d, size_t nd, const _ub * a, size_t n, _ub b, size_t o)
+{
+	register size_t i = o / UB_BIT;
+	register _udb w = 0;
+	register _ub l = 0, m = (1U << b) - 1;
+
+	if (i < n)
+	{
+		w = a[i] >> (o % UB_BIT);
+		l = UB_BIT - (_ub)(o % UB_BIT);
+		++i;
+	}
+
+	while (nd > 0)
+	{
+		if (l < b)
+		{
+			if (i < n)
+			{
+				w |= (_udb)a[i++] << l;
+				l += UB_BIT;
+			}
+			else /* The bits above a are 0. */
+				l = b;
+		}
+		d[--nd] = "0123456789abcdefghijklmnopqrstuv"[w & m];
+		w >>= b;
+		l -= b;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkChunksToDigits
+ * Description:   Converts a block array to digits a chunk at a time.
+ * Parameters:
+ *          d Pointer to nd characters. The highest digit comes first.
+ *         nd Number of digits to write. It is a multiple of pw->d and is enough for a.
+ *          a Pointer to a block array. Its content is destroyed.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to a power table.
+ * Return value:  N/A.
+ * Tip:           a is divided by pw->r with a precomputed reciprocal
+ *                and each remainder gives pw->d digits. The rest of d is filled by 0.
+ */
+static void _pbkChunksToDigits(char * d, size_t nd, _ub * a, size_t n, P_PBKPOW pw)
+{
+	do
+	{
+		nd -= pw->d;
+		_pbkFormatLimb(d + nd, pbbDivide1Inv(a, a, n, &pw->ir), pw->b, (_ub)pw->d);
+		if (n > 1 && 0 == a[n - 1])
+			--n;
+	}
+	while (n > 1 || 0 != a[0]);
+	memset(d, '0', nd);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkSinkWrite
+ * Description:   Writes characters to the output of radix conversion.
+ * Parameters:
+ *         ps Pointer to an output.
+ *          s Pointer to n characters. NULL: Write n zeros.
+ *          n Number of characters.
+ * Return value:  true:  Succeeded.
+ *                false: The callback failed.
+ * Tip:           The buffer is flushed by ps->cbf whenever it is full.
+ */
+static bool _pbkSinkWrite(P_PBKSINK ps, const char * s, size_t n)
+{
+	register size_t l;
+
+	if (ps->blead)
+	{
+		while (n > 0 && (NULL == s || '0' == *s))
+		{
+			--n;
+			if (NULL != s)
+				++s;
+		}
+		if (0 == n)
+			return true;
+		ps->blead = false;
+	}
+	while (n > 0)
+	{
+		if (ps->used == ps->size)
+		{
+			if (!ps->cbf(ps->buf, ps->used, ps->param))
+				return false;
+			ps->used = 0;
+		}
+		l = GETMIN(n, ps->size - ps->used);
+		if (NULL == s)
+			memset(ps->buf + ps->used, '0', l);
+		else
+		{
+			memcpy(ps->buf + ps->used, s, l);
+			s += l;
+		}
+		ps->used += l;
+		n -= l;
+	}
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkLeafToSink
+ * Description:   Writes a small block array as digits to the output.
+ * Parameters:
+ *         ps Pointer to an output. Its tmp holds the digits of n blocks.
+ *          a Pointer to a block array. Its content is destroyed.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to a power table.
+ *         nd Number of digits to write. It is a multiple of pw->d and is enough for a.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Zeros above the digits of a are written without converting them.
+ */
+static bool _pbkLeafToSink(P_PBKSINK ps, _ub * a, size_t n, P_PBKPOW pw, size_t nd)
+{
+	/* A block holds less than pw->d + 1 digits. */
+	register size_t m = (n * (pw->d + 1) / pw->d + 1) * pw->d;
+
+	if (m > nd)
+		m = nd;
+	_pbkChunksToDigits(ps->tmp, m, a, n, pw);
+	return _pbkSinkWrite(ps, NULL, nd - m) && _pbkSinkWrite(ps, ps->tmp, m);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBlocksToSink
+ * Description:   Writes a block array as digits to the output by divide and conquer.
+ * Parameters:
+ *         ps Pointer to an output.
+ *          a Pointer to a block array. Its content is destroyed.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to a power table that holds pw->p[k].
+ *          k Index of the power to split a at.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       a shall be less than pw->p[k] ^ 2. pw->d * 2 ^ (k + 1) digits are written.
+ * Tip:           a is divided by pw->p[k], by its reciprocal if it has one. The high half
+ *                is written before the low half with k - 1, so digits leave the highest
+ *                first and need not be stored.
+ *                Below gTuneTable.convdc blocks a is divided by pw->r repeatedly.
+ */
+static bool _pbkBlocksToSink(P_PBKSINK ps, _ub * a, size_t n, P_PBKPOW pw, size_t k)
+{
+	register size_t h = pw->d << k;
+
+	while (n > 1 && 0 == a[n - 1])
+		--n;
+
+	if (0 == k || n < gTuneTable.convdc)
+		return _pbkLeafToSink(ps, a, n, pw, 2 * h);
+
+	if (n < pw->n[k]) /* a < pw->p[k], the high half is 0. */
+		return _pbkSinkWrite(ps, NULL, h) && _pbkBlocksToSink(ps, a, n, pw, k - 1);
+	else
+	{
+		register size_t lq = n - pw->n[k] + 1;
+		register bool bok;
+		_ub * q;
+
+		if (NULL == (q = (_ub *)malloc((lq + pw->n[k]) * sizeof(_ub))))
+			return false;
+		if (NULL != pw->i[k].x)
+			bok = pbbDivideInv(q, q + lq, a, n, &pw->i[k]);
+		else
+			bok = pbbDivide(q, q + lq, a, n, pw->p[k], pw->n[k]);
+		bok = bok && _pbkBlocksToSink(ps, q, lq, pw, k - 1) &&
+			_pbkBlocksToSink(ps, q + lq, pw->n[k], pw, k - 1);
+		free(q);
+		return bok;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkZerosToBuffer
+ * Description:   Writes zeros to a range of a buffer of digits.
+ * Parameters:
+ *          d Pointer to a buffer of digits.
+ *          o Offset of the range in d. Characters before d are dropped.
+ *         nd Number of zeros.
+ * Return value:  N/A.
+ */
+static void _pbkZerosToBuffer(char * d, ptrdiff_t o, size_t nd)
+{
+	if (o < 0)
+	{
+		if ((size_t)-o >= nd)
+			return;
+		nd -= (size_t)-o;
+		o = 0;
+	}
+	memset(d + o, '0', nd);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkLeafToBuffer
+ * Description:   Writes a block array as digits to a range of a buffer.
+ * Parameters:
+ *          d Pointer to a buffer of digits.
+ *          o Offset of the range in d. Digits before d are 0 and dropped.
+ *         nd Number of digits of the range. It is a multiple of pw->d and is enough for a.
+ *          a Pointer to a block array. Its content is destroyed.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to a power table.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbkLeafToBuffer(char * d, ptrdiff_t o, size_t nd, _ub * a, size_t n, P_PBKPOW pw)
+{
+	/* A block holds less than pw->d + 1 digits. */
+	register size_t m = (n * (pw->d + 1) / pw->d + 1) * pw->d;
+	char * t;
+
+	if (m < nd)
+	{
+		_pbkZerosToBuffer(d, o, nd - m);
+		o += (ptrdiff_t)(nd - m);
+		nd = m;
+	}
+	if (o >= 0)
+		_pbkChunksToDigits(d + o, nd, a, n, pw);
+	else if ((size_t)-o < nd)
+	{
+		if (NULL == (t = (char *)malloc(nd)))
+			return false;
+		_pbkChunksToDigits(t, nd, a, n, pw);
+		memcpy(d, t - o, nd - (size_t)-o);
+		free(t);
+	}
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBlocksToBuffer
+ * Description:   Writes a block array as digits to a range of a buffer by divide and conquer.
+ * Parameters:
+ *          d Pointer to a buffer of digits.
+ *          o Offset of the range in d. Digits before d are 0 and dropped.
+ *          a Pointer to a block array. Its content is destroyed.
+ *          n Number of blocks of a. n > 0.
+ *         pw Pointer to a power table that holds pw->p[k].
+ *          k Index of the power to split a at.
+ *         wk Pointer to the current worker or NULL to run serially.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       a shall be less than pw->p[k] ^ 2. The range has pw->d * 2 ^ (k + 1) digits.
+ * Tip:           Halves split as in _pbkBlocksToSink own fixed ranges of d, so they are
+ *                written in any order. With a worker, the high half is forked to the pool
+ *                from gTuneTable.mulpar blocks while the low half is written.
+ */
+static bool _pbkBlocksToBuffer(char * d, ptrdiff_t o, _ub * a, size_t n, P_PBKPOW pw, size_t k, P_PBPWORKER wk)
+{
+	register size_t h = pw->d << k;
+
+	while (n > 1 && 0 == a[n - 1])
+		--n;
+
+	if (0 == k || n < gTuneTable.convdc)
+		return _pbkLeafToBuffer(d, o, 2 * h, a, n, pw);
+
+	/* a < pw->p[k] or the high half is dropped, the high half is 0. */
+	if (n < pw->n[k] || o + (ptrdiff_t)h <= 0)
+	{
+		_pbkZerosToBuffer(d, o, h);
+		return _pbkBlocksToBuffer(d, o + (ptrdiff_t)h, a, n, pw, k - 1, wk);
+	}
+	else
+	{
+		register size_t lq = n - pw->n[k] + 1;
+		register bool bok;
+		_ub * q;
+
+		if (NULL == (q = (_ub *)malloc((lq + pw->n[k]) * sizeof(_ub))))
+			return false;
+		if (NULL != pw->i[k].x)
+			bok = pbbDivideInv(q, q + lq, a, n, &pw->i[k]);
+		else
+			bok = pbbDivide(q, q + lq, a, n, pw->p[k], pw->n[k]);
+		if (bok && NULL != wk && n >= gTuneTable.mulpar)
+		{
+			PBKOUTJOB job;
+
+			job.task.func = _pbkBlocksTask;
+			job.task.arg = &job;
+			job.d = d;
+			job.o = o;
+			job.a = q;
+			job.n = lq;
+			job.pw = pw;
+			job.k = k - 1;
+			pbpFork(wk, &job.task);
+			bok = _pbkBlocksToBuffer(d, o + (ptrdiff_t)h, q + lq, pw->n[k], pw, k - 1, wk);
+			pbpJoin(wk, &job.task);
+			bok = bok && job.bok;
+		}
+		else
+			bok = bok && _pbkBlocksToBuffer(d, o, q, lq, pw, k - 1, NULL) &&
+				_pbkBlocksToBuffer(d, o + (ptrdiff_t)h, q + lq, pw->n[k], pw, k - 1, NULL);
+		free(q);
+		return bok;
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBlocksTask
+ * Description:   Task callback of printing a subtree of blocks.
+ * Parameters:
+ *        arg Pointer to a PBKOUTJOB.
+ *         wk Pointer to the worker who runs the task.
+ * Return value:  N/A.
+ */
+static void _pbkBlocksTask(void * arg, P_PBPWORKER wk)
+{
+	P_PBKOUTJOB pj = (P_PBKOUTJOB)arg;
+	pj->bok = _pbkBlocksToBuffer(pj->d, pj->o, pj->a, pj->n, pj->pw, pj->k, wk);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBintToSink
+ * Description:   Writes a big integer as digits of a base to an output.
+ * Parameters:
+ *         ps Pointer to an output whose buf, size, cbf and param are set. ps->used is 0.
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           A minus sign leads the digits if a is negative.
+ *                Bases of power of 2 are sliced out of the bits PBK_BITS_WIN digits at a time.
+ *                From gTuneTable.convdc blocks other bases split a by powers pw->r ^ (2 ^ k)
+ *                recursively, so the cost follows that of pbbDivide.
+ *                The rest of buf is flushed by cbf at the end.
+ */
+static bool _pbkBintToSink(P_PBKSINK ps, P_BINT a, _ub base)
+{
+	register size_t nd, l, k = 0, n = GETABS(GETFLAG(a));
+	register _ub b = _pbkPowerOfTwoBase(base);
+	register bool bok = true;
+	P_PBKPOW pw;
+	_ub * t;
+
+	ps->blead = true;
+	if (GETFLAG(a) < 0 && !pbkIsBintEqualToZero(a))
+		ps->buf[ps->used++] = '-';
+
+	if (b > 0)
+	{
+		if (NULL == (ps->tmp = (char *)malloc(PBK_BITS_WIN)))
+			return false;
+		/* Windows of digits are sliced from the highest. */
+		for (nd = (n * UB_BIT + b - 1) / b; bok && nd > 0; nd -= l)
+		{
+			l = GETMIN(nd, PBK_BITS_WIN);
+			_pbkBitsToDigits(ps->tmp, l, a->data, n, b, (nd - l) * b);
+			bok = _pbkSinkWrite(ps, ps->tmp, l);
+		}
+	}
+	else
+	{
+		if (NULL == (pw = _pbkGetPowers(base, 0)))
+			return false;
+		/* Digits of the greatest leaf. */
+		l = GETMIN(n, GETMAX(gTuneTable.convdc, 2));
+		l = (l * (pw->d + 1) / pw->d + 1) * pw->d;
+		if (NULL == (t = (_ub *)malloc(n * sizeof(_ub))))
+			return false;
+		if (NULL == (ps->tmp = (char *)malloc(l)))
+		{
+			free(t);
+			return false;
+		}
+		memcpy(t, a->data, n * sizeof(_ub));
+
+		if (n < gTuneTable.convdc)
+			bok = _pbkLeafToSink(ps, t, n, pw, l);
+		else
+		{
+			/* Find the power whose square exceeds a. */
+			while (NULL != (pw = _pbkGetPowers(base, k)) && 2 * (pw->n[k] - 1) < n)
+				++k;
+			bok = NULL != pw && _pbkBlocksToSink(ps, t, n, pw, k);
+		}
+		free(t);
+	}
+	free(ps->tmp);
+
+	if (bok && ps->blead) /* a is 0. */
+	{
+		ps->blead = false;
+		bok = _pbkSinkWrite(ps, "0", 1);
+	}
+	if (bok && NULL != ps->cbf && ps->used > 0)
+		bok = ps->cbf(ps->buf, ps->used, ps->param);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBintToBuffer
+ * Description:   Converts a big integer to a string of a base in a buffer.
+ * Parameters:
+ *          s Pointer to a buffer of l + 1 characters.
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ *          l pbkBintSzLength(a, base, false).
+ * Return value:  Length of the zero terminated string.
+ *                0: Failed.
+ * Tip:           From gTuneTable.convdc blocks other bases than powers of 2 are written
+ *                right aligned in l digits by _pbkBlocksToBuffer, and the zero the estimate
+ *                may lead with is removed. If pbpStartPool has been called, numbers of
+ *                gTuneTable.mulpar blocks or more are written by all workers.
+ *                Otherwise s is the buffer of an output that is never flushed.
+ */
+static size_t _pbkBintToBuffer(char * s, P_BINT a, _ub base, size_t l)
+{
+	register size_t k = 0, i, neg, n = GETABS(GETFLAG(a));
+	register bool bok;
+	P_PBKPOW pw;
+	P_PBPWORKER wk;
+	PBKSINK sk;
+	_ub * t;
+
+	if (_pbkPowerOfTwoBase(base) > 0 || n < gTuneTable.convdc)
+	{
+		sk.buf = s;
+		sk.size = l;
+		sk.cbf = NULL;
+		sk.param = NULL;
+		sk.used = 0;
+		if (!_pbkBintToSink(&sk, a, base))
+			return 0;
+		s[sk.used] = '\0';
+		return sk.used;
+	}
+
+	/* Find the power whose square exceeds a. */
+	while (NULL != (pw = _pbkGetPowers(base, k)) && 2 * (pw->n[k] - 1) < n)
+		++k;
+	if (NULL == pw || NULL == (t = (_ub *)malloc(n * sizeof(_ub))))
+		return 0;
+	memcpy(t, a->data, n * sizeof(_ub));
+
+	if ((neg = GETFLAG(a) < 0))
+		*s++ = '-';
+	l -= neg;
+	/* The estimate may exceed the digits of pw->p[k] ^ 2 by one. */
+	_pbkZerosToBuffer(s, 0, l - GETMIN(l, 2 * (pw->d << k)));
+
+	wk = n >= gTuneTable.mulpar ? pbpEnter() : NULL;
+	bok = _pbkBlocksToBuffer(s, (ptrdiff_t)l - (ptrdiff_t)(2 * (pw->d << k)), t, n, pw, k, wk);
+	if (NULL != wk)
+		pbpLeave(wk);
+	free(t);
+	if (!bok)
+		return 0;
+
+	for (i = 0; i + 1 < l && '0' == s[i]; ++i)
+		;
+	memmove(s, s + i, l - i);
+	s[l - i] = '\0';
+	return neg + l - i;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBintToDigits
+ * Description:   Converts a big integer to a string of a base.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ *         pn Pointer to a size_t to store the length of the string.
+ * Return value:  Pointer to the zero terminated string. Free it with free.
+ *                NULL: Failed.
+ * Tip:           The string is allocated once by pbkBintSzLength. See _pbkBintToBuffer.
+ */
+static char * _pbkBintToDigits(P_BINT a, _ub base, size_t * pn)
+{
+	register size_t l = pbkBintSzLength(a, base, false);
+	char * s;
+
+	if (0 == l || NULL == (s = (char *)malloc(l + 1)))
+		return NULL;
+	if (0 == (*pn = _pbkBintToBuffer(s, a, base, l)))
+	{
+		free(s);
+		return NULL;
+	}
+	return s;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkWriteBounded
+ * Description:   Callback of an output that copies characters into a bounded caller buffer.
+ * Parameters:
+ *          s Pointer to characters.
+ *          n Number of characters.
+ *      param Pointer to a PBKBOUND.
+ * Return value:  true.
+ * Tip:           Characters beyond the buffer are counted but not stored.
+ */
+static bool _pbkWriteBounded(const char * s, size_t n, void * param)
+{
+	register P_PBKBOUND pb = (P_PBKBOUND)param;
+
+	if (pb->n + 1 < pb->size)
+		memcpy(pb->str + pb->n, s, GETMIN(n, pb->size - 1 - pb->n));
+	pb->n += n;
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkPowerOfBase
+ * Description:   Computes a power of a base.
+ * Parameters:
+ *          p Pointer to e / 6 + 2 blocks to store the power.
+ *         pn Pointer to a size_t to store the number of blocks of p.
+ *       base Base of digits. 2 - 36.
+ *          e Exponent.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           p := base ^ e; The chunk radix r = base ^ d is raised to e / d by
+ *                squaring from the highest bit, then p is multiplied by base ^ (e % d).
+ */
+static bool _pbkPowerOfBase(_ub * p, size_t * pn, _ub base, size_t e)
+{
+	register size_t i, n = 1, q;
+	register bool bok = true;
+	_ub r, d, t = 1;
+	_ub * w;
+
+	r = _pbkBnumRadix(base, &d);
+	q = e / d;
+	for (i = e % d; i > 0; --i)
+		t *= base;
+	if (NULL == (w = (_ub *)malloc((e / 6 + 2) * sizeof(_ub))))
+		return false;
+
+	p[0] = 1;
+	for (i = sizeof(size_t) * CHAR_BIT; bok && i > 0; --i)
+	{
+		if (n > 1 || p[0] > 1)
+		{
+			if ((bok = pbbSquare(w, p, n)))
+			{
+				n *= 2;
+				memcpy(p, w, n * sizeof(_ub));
+				while (n > 1 && 0 == p[n - 1])
+					--n;
+			}
+		}
+		if ((q >> (i - 1)) & 1)
+		{
+			p[n] = pbbMultiply1(p, p, n, r);
+			if (0 != p[n])
+				++n;
+		}
+	}
+	p[n] = pbbMultiply1(p, p, n, t);
+	if (0 != p[n])
+		++n;
+
+	free(w);
+	*pn = n;
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkBnumRadix
+ * Description:   Computes the limb radix of a base.
+ * Parameters:
+ *       base Base of digits. base >= 2.
+ *         pk Pointer to a block to store the number of digits in a limb.
+ * Return value:  The greatest power of base that is a block.
+ */
+static _ub _pbkBnumRadix(_ub base, _ub * pk)
+{
+	register _ub r = base;
+	for (*pk = 1; r <= UBLOCK_FULL / base; ++*pk)
+		r *= base;
+	return r;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDivLimb
+ * Description:   Divides a double block by a limb radix.
+ * Parameters:
+ *          t A double block.
+ *          r Limb radix.
+ * Return value:  t / r;
+ * Tip:           The radix of base 10 is a constant, so compilers divide by a multiplication.
+ */
+static _udb _pbkDivLimb(_udb t, _ub r)
+{
+	return BNUM_CHUNK_BASE == r ? t / BNUM_CHUNK_BASE : t / r;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkFormatLimb
+ * Description:   Converts a limb to ASCII digits.
+ * Parameters:
+ *          d Pointer to k characters. The highest digit comes first.
+ *          x A limb.
+ *       base Base of digits.
+ *          k Digits of a limb.
+ * Return value:  N/A.
+ */
+static void _pbkFormatLimb(char * d, _ub x, _ub base, _ub k)
+{
+	if (10 == base)
+		_pbkFormatChunk(d, x);
+	else
+	{
+		while (k > 0)
+		{
+			d[--k] = "0123456789abcdefghijklmnopqrstuvwxyz"[x % base];
+			x /= base;
+		}
+	}
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkDigitsToLimbs
+ * Description:   Converts ASCII digits to limbs.
+ * Parameters:
+ *          x Pointer to (nd + k - 1) / k limbs.
+ *          s Pointer to ASCII digits of base. The highest digit comes first.
+ *         nd Number of digits.
+ *       base Base of digits.
+ *          k Digits of a limb.
+ * Return value:  Number of limbs written. The lowest limb comes first.
+ * Tip:           Decimal limbs are parsed 8 digits at a time.
+ */
+static size_t _pbkDigitsToLimbs(_ub * x, const char * s, size_t nd, _ub base, _ub k)
+{
+	register size_t i = 0, j, l;
+	register _ub t;
+
+	for (j = nd; j >= k; j -= k)
+	{
+		if (10 == base)
+			x[i++] = _pbkParseChunk(s + j - BNUM_CHUNK_DIGS);
+		else
+		{
+			for (t = 0, l = j - k; l < j; ++l)
+				t = t * base + _pbkDigitValue(s[l]);
+			x[i++] = t;
+		}
+	}
+	if (j > 0)
+	{
+		for (t = 0; j > 0; --j, ++s)
+			t = t * base + _pbkDigitValue(*s);
+		x[i++] = t;
+	}
+	return i;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkCompareLimbs
+ * Description:   Compares two limb arrays.
+ * Parameters:
+ *          a Pointer to limbs.
+ *         la Number of limbs of a.
+ *          b Pointer to limbs.
+ *         lb Number of limbs of b.
+ * Return value:  1: a > b; 0: a = b; -1: a < b.
+ * Tip:           Zero limbs on the top are allowed.
+ */
+static int _pbkCompareLimbs(const _ub * a, size_t la, const _ub * b, size_t lb)
+{
+	for (; la > lb; --la)
+		if (a[la - 1])
+			return 1;
+	for (; lb > la; --lb)
+		if (b[lb - 1])
+			return -1;
+	while (la > 0)
+	{
+		--la;
+		if (a[la] != b[la])
+			return a[la] > b[la] ? 1 : -1;
+	}
+	return 0;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkAddLimbs
+ * Description:   Adds two limb arrays.
+ * Parameters:
+ *          c Pointer to la limbs to store the sum. c can equal to a or b.
+ *          a Pointer to limbs.
+ *         la Number of limbs of a.
+ *          b Pointer to limbs.
+ *         lb Number of limbs of b. lb <= la.
+ *          r Limb radix.
+ * Return value:  The carry. 0 or 1.
+ */
+static _ub _pbkAddLimbs(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r)
+{
+	register size_t i;
+	register _udb t;
+	register _ub k = 0;
+
+	for (i = 0; i < lb; ++i)
+	{
+		t = (_udb)a[i] + b[i] + k;
+		k = t >= r;
+		c[i] = (_ub)(k ? t - r : t);
+	}
+	for (; i < la; ++i)
+	{
+		t = (_udb)a[i] + k;
+		k = t >= r;
+		c[i] = (_ub)(k ? t - r : t);
+	}
+	return k;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkSubtractLimbs
+ * Description:   Subtracts two limb arrays.
+ * Parameters:
+ *          c Pointer to la limbs to store the difference. c can equal to a or b.
+ *          a Pointer to limbs.
+ *         la Number of limbs of a.
+ *          b Pointer to limbs.
+ *         lb Number of limbs of b. lb <= la.
+ *          r Limb radix.
+ * Return value:  The borrow. 0 or 1.
+ */
+static _ub _pbkSubtractLimbs(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r)
+{
+	register size_t i;
+	register _udb t;
+	register _ub k = 0;
+
+	for (i = 0; i < la; ++i)
+	{
+		t = (_udb)(i < lb ? b[i] : 0) + k;
+		k = a[i] < t;
+		c[i] = (_ub)(k ? a[i] + (r - t) : a[i] - t);
+	}
+	return k;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkMulLimbs1
+ * Description:   Multiplies a limb array by a block.
+ * Parameters:
+ *          c Pointer to n limbs to store the product. c can equal to a.
+ *          a Pointer to limbs.
+ *          n Number of limbs.
+ *          b A block.
+ *          r Limb radix.
+ * Return value:  The carry. It is a block but can be greater than a limb.
+ */
+static _ub _pbkMulLimbs1(_ub * c, const _ub * a, size_t n, _ub b, _ub r)
+{
+	register size_t i;
+	register _udb t, q;
+	register _ub k = 0;
+
+	for (i = 0; i < n; ++i)
+	{
+		t = (_udb)a[i] * b + k;
+		q = _pbkDivLimb(t, r);
+		c[i] = (_ub)(t - q * r);
+		k = (_ub)q;
+	}
+	return k;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkAddMulLimbs1
+ * Description:   Multiplies a limb array by a limb and adds the product to another.
+ * Parameters:
+ *          c Pointer to n limbs to add the product to.
+ *          a Pointer to limbs.
+ *          n Number of limbs.
+ *          b A limb.
+ *          r Limb radix.
+ * Return value:  The carry. It is a limb.
+ * Tip:           c := c + a * b; c[i] + a[i] * b + carry < r ^ 2.
+ */
+static _ub _pbkAddMulLimbs1(_ub * c, const _ub * a, size_t n, _ub b, _ub r)
+{
+	register size_t i;
+	register _udb t, q;
+	register _ub k = 0;
+
+	for (i = 0; i < n; ++i)
+	{
+		t = (_udb)a[i] * b + c[i] + k;
+		q = _pbkDivLimb(t, r);
+		c[i] = (_ub)(t - q * r);
+		k = (_ub)q;
+	}
+	return k;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkMulLimbsBasecase
+ * Description:   Multiplies two limb arrays by schoolbook method.
+ * Parameters:
+ *          c Pointer to la + lb limbs to store the product.
+ *          a Pointer to limbs.
+ *         la Number of limbs of a.
+ *          b Pointer to limbs.
+ *         lb Number of limbs of b.
+ *          r Limb radix.
+ * Return value:  N/A.
+ */
+static void _pbkMulLimbsBasecase(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r)
+{
+	register size_t j;
+
+	memset(c, 0, la * sizeof(_ub));
+	for (j = 0; j < lb; ++j)
+		c[la + j] = _pbkAddMulLimbs1(c + j, a, la, b[j], r);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkLimbsItch
+ * Description:   Computes scratch limbs of _pbkMulLimbsKaratsuba.
+ * Parameter:
+ *          n Number of limbs of each operand.
+ * Return value:  Number of limbs.
+ */
+static size_t _pbkLimbsItch(size_t n)
+{
+	register size_t s = 0, h;
+	while (n >= gTuneTable.mulkara && n > 1)
+	{
+		h = n - (n >> 1);
+		s += 6 * h + 1;
+		n = h;
+	}
+	return s;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkAbsDiffLimbs
+ * Description:   Computes the absolute difference of the halves of a limb array.
+ * Parameters:
+ *          d Pointer to h limbs to store the difference.
+ *          a Pointer to m + h limbs.
+ *          m Number of low limbs.
+ *          h Number of high limbs. h = m or h = m + 1.
+ *          r Limb radix.
+ * Return value:  true:  The high half is less than the low half.
+ *                false: Not less.
+ */
+static bool _pbkAbsDiffLimbs(_ub * d, const _ub * a, size_t m, size_t h, _ub r)
+{
+	if (_pbkCompareLimbs(a + m, h, a, m) >= 0)
+	{
+		_pbkSubtractLimbs(d, a + m, h, a, m, r);
+		return false;
+	}
+	/* The high half is less, so its limb above m is 0. */
+	_pbkSubtractLimbs(d, a, m, a + m, m, r);
+	if (h > m)
+		d[m] = 0;
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkMulLimbsKaratsuba
+ * Description:   Multiplies two limb arrays of the same length by Karatsuba method.
+ * Parameters:
+ *          c Pointer to 2 * n limbs to store the product.
+ *          a Pointer to limbs.
+ *          b Pointer to limbs.
+ *          n Number of limbs of a and b.
+ *         ws Pointer to scratch limbs, see _pbkLimbsItch.
+ *          r Limb radix.
+ * Return value:  N/A.
+ * Tip:           a * b = z2 * r ^ 2m + (z0 + z2 -+ |a1 - a0| * |b1 - b0|) * r ^ m + z0;
+ */
+static void _pbkMulLimbsKaratsuba(_ub * c, const _ub * a, const _ub * b, size_t n, _ub * ws, _ub r)
+{
+	register size_t m = n >> 1, h = n - m;
+	_ub * da = ws, * db = ws + h, * t = ws + 2 * h, * u = ws + 4 * h;
+	bool bneg;
+
+	if (n < gTuneTable.mulkara || n < 2)
+	{
+		_pbkMulLimbsBasecase(c, a, n, b, n, r);
+		return;
+	}
+
+	bneg  = _pbkAbsDiffLimbs(da, a, m, h, r);
+	bneg ^= _pbkAbsDiffLimbs(db, b, m, h, r);
+
+	_pbkMulLimbsKaratsuba(c, a, b, m, ws + 6 * h + 1, r);
+	_pbkMulLimbsKaratsuba(c + 2 * m, a + m, b + m, h, ws + 6 * h + 1, r);
+	_pbkMulLimbsKaratsuba(t, da, db, h, ws + 6 * h + 1, r);
+
+	/* u := z0 + z2 -+ t. */
+	memcpy(u, c + 2 * m, 2 * h * sizeof(_ub));
+	u[2 * h] = _pbkAddLimbs(u, u, 2 * h, c, 2 * m, r);
+	if (bneg)
+		u[2 * h] += _pbkAddLimbs(u, u, 2 * h, t, 2 * h, r);
+	else
+		u[2 * h] -= _pbkSubtractLimbs(u, u, 2 * h, t, 2 * h, r);
+
+	_pbkAddLimbs(c + m, c + m, 2 * n - m, u, 2 * h + 1, r);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkMulLimbs
+ * Description:   Multiplies two limb arrays.
+ * Parameters:
+ *          c Pointer to la + lb limbs to store the product.
+ *          a Pointer to limbs.
+ *         la Number of limbs of a.
+ *          b Pointer to limbs.
+ *         lb Number of limbs of b. 0 < lb <= la.
+ *          r Limb radix.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           a is cut into pieces of lb limbs. Each piece is multiplied by b
+ *                with Karatsuba method and added to c.
+ */
+static bool _pbkMulLimbs(_ub * c, const _ub * a, size_t la, const _ub * b, size_t lb, _ub r)
+{
+	register size_t i;
+	register bool bok = true;
+	_ub * ws, * t;
+
+	if (lb < gTuneTable.mulkara || lb < 2)
+	{
+		_pbkMulLimbsBasecase(c, a, la, b, lb, r);
+		return true;
+	}
+
+	i = _pbkLimbsItch(lb);
+	if (NULL == (ws = (_ub *)malloc((i + 2 * lb) * sizeof(_ub))))
+		return false;
+	t = ws + i;
+
+	memset(c, 0, (la + lb) * sizeof(_ub));
+	for (i = 0; i + lb <= la; i += lb)
+	{
+		_pbkMulLimbsKaratsuba(t, a + i, b, lb, ws, r);
+		_pbkAddLimbs(c + i, c + i, la + lb - i, t, 2 * lb, r);
+	}
+	if (i < la)
+	{
+		if ((bok = _pbkMulLimbs(t, b, lb, a + i, la - i, r)))
+			_pbkAddLimbs(c + i, c + i, la + lb - i, t, la + lb - i, r);
+	}
+
+	free(ws);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkAddSubtractBnum
+ * Description:   Adds or subtracts two big numbers.
+ * Parameters:
+ *          c Pointer to a big number to store the result.
+ *          a Pointer to a big number.
+ *          b Pointer to a big number.
+ *       bsub true: c := a - b; false: c := a + b;
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Magnitudes are added when the signs agree, otherwise the less is subtracted.
+ */
+static bool _pbkAddSubtractBnum(P_BNUM c, P_BNUM a, P_BNUM b, bool bsub)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || GETBASE(a) != GETBASE(b))
+		return false;
+	else
+	{
+		register size_t la = GETABS(GETFLAG(a)), lb = GETABS(GETFLAG(b));
+		register bool na = GETFLAG(a) < 0, nb = (GETFLAG(b) < 0) != bsub;
+		register _ub r;
+		_ub k;
+
+		r = _pbkBnumRadix(GETBASE(a), &k);
+		/* c can be a or b, so neither is read before c grows. */
+		if (!pbkReallocBnum(c, (_ub)(GETMAX(la, lb) + 1), true))
+			return false;
+
+		if (na == nb)
+		{
+			if (la >= lb)
+				c->data[la] = _pbkAddLimbs(c->data, a->data, la, b->data, lb, r);
+			else
+				c->data[lb] = _pbkAddLimbs(c->data, b->data, lb, a->data, la, r);
+			SETFLAG(c, (_ib)GETMAX(la, lb) + 1);
+		}
+		else if (_pbkCompareLimbs(a->data, la, b->data, lb) >= 0)
+		{
+			_pbkSubtractLimbs(c->data, a->data, la, b->data, lb, r);
+			SETFLAG(c, (_ib)la);
+		}
+		else
+		{
+			_pbkSubtractLimbs(c->data, b->data, lb, a->data, la, r);
+			SETFLAG(c, (_ib)lb);
+			na = nb;
+		}
+
+		SETBASE(c, GETBASE(a));
+		pbkShrinkZeroFlag(c);
+		if (na && !pbkIsBintEqualToZero(c))
+			SETFLAG(c, -GETFLAG(c));
+		return true;
+	}
+}
+
+/* Function name: pbkBintToBnum
+ * Description:   Convert a big integer to a big number of its own base.
+ * Parameters:
+ *          x Pointer to an initialized big number.
+ *          a Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           The digits come from pbkBintToSz and are packed into limbs.
+ *                Bases of power of 2 take linear time.
+ */
+bool pbkBintToBnum(P_BNUM x, P_BINT a)
+{
+	if (pbkIsNotANumber(a) || GETBASE(x) < 2 || GETBASE(x) > 36)
+		return false;
+	else
+	{
+		register size_t j;
+		size_t n;
+		_ub k;
+		char * s;
+
+		_pbkBnumRadix(GETBASE(x), &k);
+		if (NULL == (s = _pbkBintToDigits(a, GETBASE(x), &n)))
+			return false;
+		j = '-' == s[0];
+		if (!pbkReallocBnum(x, (_ub)((n - j + k - 1) / k), true))
+		{
+			free(s);
+			return false;
+		}
+
+		SETFLAG(x, (_ib)_pbkDigitsToLimbs(x->data, s + j, n - j, GETBASE(x), k));
+		free(s);
+		if (j)
+			SETFLAG(x, -GETFLAG(x));
+		return true;
+	}
+}
+
+/* Function name: pbkBintToDecimalBnum
+ * Description:   Convert a big integer to base 10 big number.
+ * Parameters:
+ *          x Pointer to a big number.
+ *          a Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           This function is used to output a big integer.
+ *                The digits come from pbkBintToDecimalSz and are packed BNUM_CHUNK_DIGS per limb.
+ */
+bool pbkBintToDecimalBnum(P_BNUM x, P_BINT a)
+{
+	SETBASE(x, 10);
+	return pbkBintToBnum(x, a);
+}
+
+/* Function name: pbkBintToSz
+ * Description:   Convert a big integer to a string of a base.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ * Return value:  Pointer to a new zero terminated string.
+ *                NULL: Failed.
+ * Caution:       Free the string by function free.
+ * Tip:           A minus sign leads the digits if a is negative. Digits above 9 are a-z.
+ *                Bases 2, 4, 8, 16 and 32 slice the bits of a in linear time.
+ *                Other bases divide a copy of a, see pbkBintToDecimalSz.
+ */
+char * pbkBintToSz(P_BINT a, _ub base)
+{
+	size_t n;
+	if (pbkIsNotANumber(a) || base < 2 || base > 36)
+		return NULL;
+	return _pbkBintToDigits(a, base, &n);
+}
+
+/* Function name: pbkBintToDecimalSz
+ * Description:   Convert a big integer to a base 10 presented string.
+ * Parameter:
+ *          a Pointer to a big integer.
+ * Return value:  Pointer to a new zero terminated string.
+ *                NULL: Failed.
+ * Caution:       Free the string by function free.
+ * Tip:           A minus sign leads the digits if a is negative.
+ *                A copy of a is divided by BNUM_CHUNK_BASE with a precomputed reciprocal
+ *                and each remainder gives BNUM_CHUNK_DIGS digits through a table of digit pairs.
+ *                From gTuneTable.convdc blocks a is split by powers 10 ^ (BNUM_CHUNK_DIGS * 2 ^ k)
+ *                recursively, so the cost follows that of pbbDivide.
+ */
+char * pbkBintToDecimalSz(P_BINT a)
+{
+	return pbkBintToSz(a, 10);
+}
+
+/* Function name: pbkBintSzLength
+ * Description:   Count the characters of a big integer in a base.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ *     bexact true:  Return the exact count.
+ *            false: Return an upper bound that is at most 1 greater.
+ * Return value:  Number of characters of pbkBintToSz(a, base), not including the terminating zero.
+ *                0: a is not a number or base is wrong.
+ * Tip:           The bound is (bit length of a) * log(2) / log(base) + 1 plus a minus sign.
+ *                It is exact for bases of power of 2. Otherwise the exact count compares a with
+ *                a power of base, which costs about one multiplication of the size of a.
+ */
+size_t pbkBintSzLength(P_BINT a, _ub base, bool bexact)
+{
+	register size_t n = GETABS(GETFLAG(a)), bits, nd, neg;
+	register _ub b = _pbkPowerOfTwoBase(base), t;
+
+	if (pbkIsNotANumber(a) || base < 2 || base > 36)
+		return 0;
+	if (pbkIsBintEqualToZero(a))
+		return 1;
+
+	neg = GETFLAG(a) < 0;
+	for (bits = (n - 1) * UB_BIT, t = a->data[n - 1]; t > 0; t >>= 1)
+		++bits;
+	if (b > 0)
+		return neg + (bits + b - 1) / b;
+
+	/* The product errs far less than 0.001 for any size that fits in memory. */
+	nd = (size_t)((double)bits * log(2.0) / log((double)base) + 0.001) + 1;
+	if (bexact)
+	{
+		size_t l;
+		_ub * p;
+
+		if (NULL == (p = (_ub *)malloc((nd / 6 + 2) * sizeof(_ub))))
+			return 0;
+		if (!_pbkPowerOfBase(p, &l, base, nd - 1))
+		{
+			free(p);
+			return 0;
+		}
+		/* a has nd digits if a >= base ^ (nd - 1). */
+		while (nd > 1 && (n < l || (n == l && pbbCompare(a->data, p, n) < 0)))
+		{
+			--nd;
+			pbbDivide1(p, p, l, base);
+			if (l > 1 && 0 == p[l - 1])
+				--l;
+		}
+		free(p);
+	}
+	return neg + nd;
+}
+
+/* Function name: pbkBintToSzN
+ * Description:   Convert a big integer to a string of a base in a buffer of a size.
+ * Parameters:
+ *        str Pointer to a buffer. It can be NULL if size is 0.
+ *       size Capacity of str including the terminating zero.
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ * Return value:  Number of characters of the whole string, not including the terminating zero.
+ *                0: Failed.
+ * Caution:       If the return value is not less than size, the string is cut off.
+ * Tip:           Works like snprintf. The digits are converted once in either case:
+ *                A buffer larger than pbkBintSzLength(a, base, false) is written directly,
+ *                otherwise the digits are streamed and those beyond the buffer are only counted.
+ */
+size_t pbkBintToSzN(char * str, size_t size, P_BINT a, _ub base)
+{
+	register bool bok;
+	PBKSINK sk;
+	PBKBOUND bd;
+
+	if (0 == (sk.size = pbkBintSzLength(a, base, false)))
+		return 0;
+	if (size > sk.size)
+		return _pbkBintToBuffer(str, a, base, sk.size);
+
+	bd.str = str;
+	bd.size = size;
+	bd.n = 0;
+	if (NULL == (sk.buf = (char *)malloc(BINT_STREAM_SIZE)))
+		return 0;
+	sk.size = BINT_STREAM_SIZE;
+	sk.used = 0;
+	sk.cbf = _pbkWriteBounded;
+	sk.param = &bd;
+	bok = _pbkBintToSink(&sk, a, base);
+	free(sk.buf);
+	if (!bok)
+		return 0;
+	if (size > 0)
+		str[GETMIN(bd.n, size - 1)] = '\0';
+	return bd.n;
+}
+
+/* Function name: pbkBintToStream
+ * Description:   Write a big integer as digits of a base through a callback.
+ * Parameters:
+ *          a Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ *        cbf Callback that writes characters. See CBF_PBKWRITE.
+ *      param Parameter passed to cbf.
+ * Return value:  true:  Succeeded.
+ *                false: Failed, or cbf returned false.
+ * Tip:           The digits are the same as those of pbkBintToSz, but never held in memory at once.
+ *                The divide and conquer split writes the highest part first into a buffer of
+ *                BINT_STREAM_SIZE characters, and cbf is called each time it fills.
+ */
+bool pbkBintToStream(P_BINT a, _ub base, CBF_PBKWRITE cbf, void * param)
+{
+	register bool bok;
+	PBKSINK sk;
+
+	if (pbkIsNotANumber(a) || base < 2 || base > 36 || NULL == cbf)
+		return false;
+	if (NULL == (sk.buf = (char *)malloc(BINT_STREAM_SIZE)))
+		return false;
+	sk.size = BINT_STREAM_SIZE;
+	sk.used = 0;
+	sk.cbf = cbf;
+	sk.param = param;
+	bok = _pbkBintToSink(&sk, a, base);
+	free(sk.buf);
+	return bok;
+}
+
+/* Function name: pbkBnumToBint
+ * Description:   Convert a big number of any base to base 2 big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *          a Pointer to a big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           The limbs are written out as digits and read by pbkSzToBint.
+ */
+bool pbkBnumToBint(P_BINT x, P_BNUM a)
+{
+	if (pbkIsNotANumber(a))
+		return false;
+	else
+	{
+		register size_t i, n = GETABS(GETFLAG(a));
+		register bool bok;
+		_ub k;
+		char * s;
+
+		_pbkBnumRadix(GETBASE(a), &k);
+		/* Limbs of a big number come lowest first. */
+		if (NULL == (s = (char *)malloc(n * k)))
+			return false;
+		for (i = 0; i < n; ++i)
+			_pbkFormatLimb(s + (n - 1 - i) * k, a->data[i], GETBASE(a), k);
+		bok = _pbkDigitsToBint(x, s, n * k, GETBASE(a));
+		free(s);
+		if (!bok)
+			return false;
+
+		if (GETFLAG(a) < 0 && !pbkIsBintEqualToZero(x))
+			SETFLAG(x, -GETFLAG(x));
+		return true;
+	}
+}
+
+/* Function name: pbkDecimalBnumToBint
+ * Description:   Convert a big number to base 2 big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *          a Pointer to a big number.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The base of a shall be 10.
+ * Tip:           This function is used to input a big integer from a big number.
+ *                BNUM_CHUNK_DIGS digits are converted at a time with one pbbMultiply1.
+ *                From gTuneTable.convdc blocks the digits are split in halves recursively
+ *                and joined by x := hi * 10 ^ (BNUM_CHUNK_DIGS * 2 ^ k) + lo; with pbbMultiply.
+ */
+bool pbkDecimalBnumToBint(P_BINT x, P_BNUM a)
+{
+	if (10 != GETBASE(a))
+		return false;
+	return pbkBnumToBint(x, a);
+}
+
+/* Function name: pbkSzToBint
+ * Description:   Convert a string of a base to big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *        str Pointer to a string.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       This string shall contain digits of base only. And Shall not contain minus sign(-).
+ * Tip:           Digits above 9 are a-z or A-Z.
+ *                Bases 2, 4, 8, 16 and 32 are shifted into the blocks in linear time.
+ *                Other bases are converted a chunk at a time, see pbkDecimalBnumToBint.
+ *                The length is taken by strlen, see pbkSzNToBint.
+ */
+bool pbkSzToBint(P_BINT x, const char * str, _ub base)
+{
+	return pbkSzNToBint(x, str, strlen(str), base);
+}
+
+/* Function name: pbkSzNToBint
+ * Description:   Convert characters of a base to big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *        str Pointer to characters. They need not end with a zero.
+ *          n Number of characters.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The characters shall be digits of base only. And Shall not contain minus sign(-).
+ * Tip:           Only str[0] to str[n - 1] are read, so a number can be converted where it lies,
+ *                such as in a mapped file. If pbpStartPool has been called, validation of
+ *                2 * PBK_CHECK_PAR characters or more is split on the worker pool, and so is
+ *                the conversion from gTuneTable.mulpar blocks.
+ */
+bool pbkSzNToBint(P_BINT x, const char * str, size_t n, _ub base)
+{
+	register bool bok;
+	P_PBPWORKER wk;
+
+	if (0 == n || base < 2 || base > 36)
+		return false;
+	wk = n >= 2 * PBK_CHECK_PAR ? pbpEnter() : NULL;
+	bok = _pbkIsDigitsPar(str, n, base, wk);
+	if (NULL != wk)
+		pbpLeave(wk);
+	return bok && _pbkDigitsToBint(x, str, n, base);
+}
+
+/* Function name: pbkPreparePowers
+ * Description:   Prepare the shared powers that radix conversion of a base needs.
+ * Parameters:
+ *       base Base of digits. 2 - 36.
+ *     digits Number of digits of the greatest number to convert.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Conversions compute powers of base and their reciprocals on demand and
+ *                keep them for the whole process, so this function is never required.
+ *                Call it before threads start converting numbers, so none of them waits for
+ *                the others to square the powers, or before pbxSavePowers.
+ */
+bool pbkPreparePowers(_ub base, size_t digits)
+{
+	register size_t k = 0;
+	_ub d;
+
+	if (base < 2 || base > 36)
+		return false;
+	_pbkBnumRadix(base, &d);
+	while (k + 1 < PBK_POW_MAX && (d << k) < digits)
+		++k;
+	return NULL != _pbkGetPowers(base, k);
+}
+
+/* Function name: pbkGetPower
+ * Description:   Get a shared power of a base.
+ * Parameters:
+ *         pp Pointer to a PBKPOWER to fill.
+ *       base Base of digits. 2 - 36.
+ *          i Index of the power.
+ * Return value:  true:  Succeeded.
+ *                false: The power has not been computed.
+ * Caution:       The blocks pp points to belong to the library. Do not change them.
+ */
+bool pbkGetPower(P_PBKPOWER pp, _ub base, size_t i)
+{
+	register P_PBKPOW pw;
+
+	if (base < 2 || base > 36)
+		return false;
+	pw = &_pbkPowCache[base];
+	if (PBK_LOAD(pw->k) <= i)
+		return false;
+	pp->p = pw->p[i];
+	pp->n = pw->n[i];
+	pp->x = pw->i[i].x;
+	return true;
+}
+
+/* Function name: pbkPutPower
+ * Description:   Add a shared power of a base, such as one loaded from a file.
+ * Parameters:
+ *       base Base of digits. 2 - 36.
+ *          i Index of the power.
+ *         pp Pointer to the power. pp->x can be NULL.
+ * Return value:  true:  Succeeded, or the power is already there.
+ *                false: Powers below i are missing, the power is wrong or memory ran out.
+ * Tip:           Powers shall be added from index 0 up. Each is checked modulo a prime
+ *                against the square of the last one, so it costs linear time.
+ *                A reciprocal is checked by one multiplication, which is cheaper than pbbInvert.
+ */
+bool pbkPutPower(_ub base, size_t i, P_PBKPOWER pp)
+{
+	register P_PBKPOW pw;
+	register bool bok = false;
+	register _udb r;
+	_ub * p;
+
+	if (base < 2 || base > 36 || i >= PBK_POW_MAX || 0 == pp->n || 0 == pp->p[pp->n - 1] || (NULL != pp->x && pp->n < 2))
+		return false;
+	pw = &_pbkPowCache[base];
+	if (PBK_LOAD(pw->k) > i)
+		return true;
+
+	PBK_POW_LOCK();
+	if (0 == pw->k && !_pbkGrowPowers(pw, base, 0))
+		goto Lbl_Unlock;
+	if (pw->k > i)
+		bok = true;
+	else if (pw->k == i && (pp->n + 1) / 2 == pw->n[i - 1])
+	{
+		r = _pbkResidue(pw->p[i - 1], pw->n[i - 1]);
+		if (r * r % PBK_POW_PRIME == _pbkResidue(pp->p, pp->n) &&
+			NULL != (p = (_ub *)malloc((3 * pp->n + 1) * sizeof(_ub))))
+		{
+			memcpy(p, pp->p, pp->n * sizeof(_ub));
+			if (NULL != pp->x)
+				memcpy(p + 2 * pp->n, pp->x, (pp->n + 1) * sizeof(_ub));
+			bok = _pbkPushPower(pw, p, pp->n, NULL != pp->x);
+		}
+	}
+Lbl_Unlock:
+	PBK_POW_UNLOCK();
+	return bok;
+}
+
+/* Function name: pbkFreePowers
+ * Description:   Free the shared powers of all bases.
+ * Parameters:    N/A.
+ * Return value:  N/A.
+ * Caution:       No thread shall convert numbers while this function runs.
+ */
+void pbkFreePowers(void)
+{
+	register size_t i;
+
+	PBK_POW_LOCK();
+	for (i = 0; i < sizeof(_pbkPowCache) / sizeof(_pbkPowCache[0]); ++i)
+	{
+		register P_PBKPOW pw = &_pbkPowCache[i];
+
+		while (pw->k > 0)
+		{
+			free(pw->p[pw->k - 1]);
+			PBK_STORE(pw->k, pw->k - 1);
+		}
+	}
+	PBK_POW_UNLOCK();
+}
+
+/* Function name: pbkDecimalSzToBint
+ * Description:   Convert a base 10 presented string to big integer.
+ * Parameters:
+ *          x Pointer to a big integer.
+ *        str Pointer to a string.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       This string shall contain ASCII number 0-9. And Shall not contain minus sign(-).
+ * Tip:           The digits are checked 8 at a time, then converted BNUM_CHUNK_DIGS at a time
+ *                without a big number in between. See pbkDecimalBnumToBint.
+ */
+bool pbkDecimalSzToBint(P_BINT x, const char * str)
+{
+	return pbkSzToBint(x, str, 10);
+}
+
@@ -1,131 +1,226 @@
-/*
- * Name:        pbk.h
- * Description: Portable big integer library kernel.
- * Author:      cosh.cage#hotmail.com
- * File ID:     0520240323A0907251909L00141
- * License:     GPLv3.
- */
-
-#ifndef _PBK_H_
-#define _PBK_H_
-
-#include <stddef.h>  /* Using type size_t and ptrdiff_t. */
-#include <limits.h>  /* Using macro CHAR_BIT. */
-#include <stdbool.h> /* Boolean type and constants. */
-
-#define BINT_INIT_SIZE 1024U /* Initial big integer size. */
-#define BINT_INIT_INCL 1024U /* Initial big integer incremental. */
-
-#define BNUM_INIT_SIZE 8192U /* Initial big number size. */
-#define BNUM_INIT_INCL 4096U /* Initial big number incremental. */
-
-/* Predefined data type. */
-typedef int                _ib;  /* Integer block. */
-typedef unsigned int       _ub;  /* Unsigned integer block. */
-typedef long long          _idb; /* Integer double block. */
-typedef unsigned long long _udb; /* Unsigned integer double block. */
-
-#define UBLOCK_FULL (~(_ub)0)
-#define IBLOCK_FULL ((_ib)((UBLOCK_FULL) >> 1))
-#define UB_BIT      (sizeof(_ub) * CHAR_BIT)
-#define CARRY(udb)  (((_udb)udb) >> UB_BIT)
-
-/* Big integer type. */
-typedef struct st_BINT
-{
-	_ib    flag; /* Real capacity and sign. */
-	_ub    size; /* Allocated capacity. */
-	_ub    incl; /* Incremental. */
-	_ub *  data; /* Data pointer. */
-} BINT, * P_BINT;
-
-typedef struct st_BNUM
-{
-	_ib    flag; /* Real capacity and sign. */
-	_ub    size; /* Allocated capacity. */
-	_ub    incl; /* Incremental. */
-	_ub    base; /* Base. */
-	char * data; /* Data pointer. */
-} BNUM, * P_BNUM;
-
-/* Unsigned block integer division. */
-typedef struct _st_ubdiv_t
-{
-	_ub quot; /* Quotient.  */
-	_ub rem;  /* Remainder. */
-} _ubdiv_t;
-
-/* Useful macros. */
-#define GETABS(ib)   ((_ub)((ib) >= 0 ? (ib) : -(ib)))
-#define GETMAX(a, b) ((a) >= (b) ? (a) : (b))
-#define GETMIN(a, b) ((a) <= (b) ? (a) : (b))
-#define GETSGN(ib)   ((ib) > 0 ? 1 : ((ib) < 0 ? -1 : 0))
-
-#define GETFLAG(pbi) ((pbi)->flag)
-#define GETSIZE(pbi) ((pbi)->size)
-#define GETINCL(pbi) ((pbi)->incl)
-#define GETBASE(pbn) ((pbn)->base)
-
-#define SETFLAG(pbi, ib) (GETFLAG(pbi) = (ib))
-#define SETSIZE(pbi, ub) (GETSIZE(pbi) = (ub))
-#define SETINCL(pbi, ub) (GETINCL(pbi) = (ub))
-#define SETBASE(pbn, ub) (GETBASE(pbn) = (ub))
-
-#define pbkIsNotANumber(pbi) ((pbi)->flag == 0)
-
-#define pbkShrinkZeroFlag(pbi)                     \
-do                                                 \
-{                                                  \
-	register size_t _i, _j = GETABS(GETFLAG(pbi)); \
-	for (_i = GETABS(GETFLAG(pbi)); _i > 1; --_i)  \
-	{                                              \
-		if (0 == (pbi)->data[_i - 1])              \
-			--_j;                                  \
-		else                                       \
-			break;                                 \
-	}                                              \
-	if (GETFLAG(pbi) >= 0)                         \
-		SETFLAG(pbi,  (_ib)_j);                    \
-	else                                           \
-		SETFLAG(pbi, -(_ib)_j);                    \
-}                                                  \
-while (0);
-
-#define pbkIsBintEqualToZero(pbi) (1 == GETABS(GETFLAG(pbi)) && !(*(pbi)->data))
-
-/* Functions for big integers. */
-bool   pbkInitBint       (P_BINT pbi, _ib  i);
-bool   pbkReallocBint    (P_BINT pbi, _ub  size, bool binc);
-void   pbkFreeBint       (P_BINT pbi);
-P_BINT pbkCreateBint     (_ib    i);
-void   pbkDeleteBint     (P_BINT pbi);
-bool   pbkMoveBint       (P_BINT a, P_BINT b);
-P_BINT pbkCopyBint       (P_BINT a);
-bool   pbkIbToBint       (P_BINT a, _ib    i);
-_ib    pbkBintToIb       (P_BINT a);
-int    pbkCompareBint    (P_BINT a, P_BINT b);
-bool   pbkAddBint        (P_BINT c, P_BINT a,    P_BINT   b);
-bool   pbkSubtractBint   (P_BINT c, P_BINT a,    P_BINT   b);
-bool   pbkLeftShiftBint  (P_BINT a, _ub    blocks, _ub    bits);
-bool   pbkRightShiftBint (P_BINT a, _ub    blocks, _ub    bits);
-bool   pbkMultiplyBintOld(P_BINT c, P_BINT a,    P_BINT   b);
-bool   pbkMultiplyBintNew(P_BINT c, P_BINT a,    P_BINT   b);
-bool   pbkMultiplyBintFFT(P_BINT c, P_BINT a,    P_BINT   b);
-bool   pbkDivideBint     (P_BINT q, P_BINT r,    P_BINT   a, P_BINT b);
-/* Functions for big numbers. */
-bool   pbkInitBnum         (P_BNUM pbn, _ub    base);
-bool   pbkReallocBnum      (P_BNUM pbn, _ub    size, bool binc);
-void   pbkFreeBnum         (P_BNUM pbn);
-P_BNUM pbkCreateBnum       (_ub    base);
-void   pbkDeleteBnum       (P_BNUM pbn);
-bool   pbkMoveBnum         (P_BNUM a,   P_BNUM b);
-bool   pbkIbToBnum         (P_BNUM pbn, _ib    n);
-bool   pbkDecimalSzToBnum  (P_BNUM pbn, const char * str);
-void   pbkPrintBnum        (P_BNUM pbn);
-bool   pbkBintToDecimalBnum(P_BNUM x,   P_BINT a);
-bool   pbkDecimalBnumToBint(P_BINT x,   P_BNUM a);
-
-#define pbkMultiplyBint pbkMultiplyBintNew
-
-#endif
-
+﻿/*
+ * Name:        pbk.h
+ * Description: Portable big integer library kernel.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     0520240323A1019261720L00226
+ * License:     GPLv3.
+ */
+
+#ifndef _PBK_H_
+#define _PBK_H_
+
+#include <stddef.h>  /* Using type size_t and ptrdiff_t. */
+#include <limits.h>  /* Using macro CHAR_BIT. */
+#include <stdbool.h> /* Boolean type and constants. */
+
+#define BINT_INIT_SIZE 1024U /* Initial big integer size. */
+#define BINT_INIT_INCL 1024U /* Initial big integer incremental. */
+
+#define BNUM_INIT_SIZE 1024U /* Initial big number size. */
+#define BNUM_INIT_INCL 1024U /* Initial big number incremental. */
+
+/* Greatest power of 10 in a block of 32 or 64 bits, and decimal digits of BNUM_CHUNK_BASE - 1. */
+#define BNUM_CHUNK_BASE (8U == sizeof(_ub) ? (_ub)10000000000000000000ULL : (_ub)1000000000U)
+#define BNUM_CHUNK_DIGS (8U == sizeof(_ub) ? 19U : 9U)
+
+#define BINT_STREAM_SIZE 65536U /* Characters buffered by streaming output. */
+
+/* Default thresholds in blocks. Run Samples/pbtune.c to measure them on a host. */
+#ifndef BINT_MUL_KARA
+#define BINT_MUL_KARA   32U     /* Blocks from which Karatsuba multiplication is used. */
+#endif
+#ifndef BINT_MUL_TOOM
+#define BINT_MUL_TOOM   320U    /* Blocks from which Toom-3 multiplication is used. */
+#endif
+#ifndef BINT_MUL_FFT
+#define BINT_MUL_FFT    10240U  /* Blocks from which FFT multiplication is used. */
+#endif
+#ifndef BINT_MUL_PAR
+#define BINT_MUL_PAR    1024U   /* Blocks from which sub-products run on the worker pool. */
+#endif
+#ifndef BINT_MUL_PFFT
+#define BINT_MUL_PFFT   65536U  /* Blocks from which FFT multiplication is used while the pool runs. */
+#endif
+#ifndef BINT_DIV_BZ
+#define BINT_DIV_BZ     40U     /* Blocks of divisor and quotient from which Burnikel-Ziegler division is used. */
+#endif
+#ifndef BINT_DIV_NEWTON
+#define BINT_DIV_NEWTON 262144U /* Blocks of divisor and quotient from which Newton division is used. */
+#endif
+#ifndef BINT_CONV_DC
+#define BINT_CONV_DC    32U     /* Blocks from which radix conversion divides and conquers. */
+#endif
+
+/* Predefined data type. */
+typedef int                _ib;  /* Integer block. */
+typedef unsigned int       _ub;  /* Unsigned integer block. */
+typedef long long          _idb; /* Integer double block. */
+typedef unsigned long long _udb; /* Unsigned integer double block. */
+
+#define UBLOCK_FULL (~(_ub)0)
+#define IBLOCK_FULL ((_ib)((UBLOCK_FULL) >> 1))
+#define UB_BIT      (sizeof(_ub) * CHAR_BIT)
+#define CARRY(udb)  (((_udb)udb) >> UB_BIT)
+
+/* Big integer type. */
+typedef struct st_BINT
+{
+	_ib    flag; /* Real capacity and sign. */
+	_ub    size; /* Allocated capacity. */
+	_ub    incl; /* Incremental. */
+	_ub *  data; /* Data pointer. */
+} BINT, * P_BINT;
+
+typedef struct st_BNUM
+{
+	_ib    flag; /* Real capacity and sign. */
+	_ub    size; /* Allocated capacity. */
+	_ub    incl; /* Incremental. */
+	_ub    base; /* Base of digits. 2 - 36. */
+	_ub *  data; /* Limbs. Each limb holds as many digits as a block can. */
+} BNUM, * P_BNUM;
+
+/* Callback of streaming output. It writes n characters of s and returns false on failure. */
+typedef bool (* CBF_PBKWRITE)(const char * s, size_t n, void * param);
+
+/* A power of a base shared by radix conversions. r ^ (2 ^ i) where r is the greatest power of the base in a block. */
+typedef struct st_PBKPOWER
+{
+	const _ub * p; /* The power. */
+	size_t      n; /* Blocks of p. */
+	const _ub * x; /* n + 1 blocks. floor(B ^ (2 * n) / d), d is p shifted until its highest bit is set. NULL: None. */
+} PBKPOWER, * P_PBKPOWER;
+
+/* Transformed big integer type for FFT multiplication. */
+typedef struct st_TBINT
+{
+	_ib      flag; /* Real capacity and sign of the original big integer. */
+	size_t   size; /* Transform length. */
+	_ub      bits; /* Bits of each transform digit. */
+	double * data; /* Spectrum and twiddle factors. */
+} TBINT, * P_TBINT;
+
+/* Tuning table of algorithm thresholds. */
+typedef struct st_PBKTUNE
+{
+	_ub mulkara;   /* Karatsuba multiplication threshold. */
+	_ub multoom;   /* Toom-3 multiplication threshold. */
+	_ub mulfft;    /* FFT multiplication threshold. */
+	_ub mulpar;    /* Parallel multiplication cutoff. */
+	_ub mulpfft;   /* FFT multiplication threshold while the worker pool runs. */
+	_ub divbz;     /* Burnikel-Ziegler division threshold. */
+	_ub divnewton; /* Newton division threshold. */
+	_ub convdc;    /* Divide and conquer radix conversion threshold. */
+} PBKTUNE, * P_PBKTUNE;
+
+/* Unsigned block integer division. */
+typedef struct _st_ubdiv_t
+{
+	_ub quot; /* Quotient.  */
+	_ub rem;  /* Remainder. */
+} _ubdiv_t;
+
+/* Useful macros. */
+#define GETABS(ib)   ((_ub)((ib) >= 0 ? (ib) : -(ib)))
+#define GETMAX(a, b) ((a) >= (b) ? (a) : (b))
+#define GETMIN(a, b) ((a) <= (b) ? (a) : (b))
+#define GETSGN(ib)   ((ib) > 0 ? 1 : ((ib) < 0 ? -1 : 0))
+
+#define GETFLAG(pbi) ((pbi)->flag)
+#define GETSIZE(pbi) ((pbi)->size)
+#define GETINCL(pbi) ((pbi)->incl)
+#define GETBASE(pbn) ((pbn)->base)
+
+#define SETFLAG(pbi, ib) (GETFLAG(pbi) = (ib))
+#define SETSIZE(pbi, ub) (GETSIZE(pbi) = (ub))
+#define SETINCL(pbi, ub) (GETINCL(pbi) = (ub))
+#define SETBASE(pbn, ub) (GETBASE(pbn) = (ub))
+
+#define pbkIsNotANumber(pbi) ((pbi)->flag == 0)
+
+#define pbkShrinkZeroFlag(pbi)                     \
+do                                                 \
+{                                                  \
+	register size_t _i, _j = GETABS(GETFLAG(pbi)); \
+	for (_i = GETABS(GETFLAG(pbi)); _i > 1; --_i)  \
+	{                                              \
+		if (0 == (pbi)->data[_i - 1])              \
+			--_j;                                  \
+		else                                       \
+			break;                                 \
+	}                                              \
+	if (GETFLAG(pbi) >= 0)                         \
+		SETFLAG(pbi,  (_ib)_j);                    \
+	else                                           \
+		SETFLAG(pbi, -(_ib)_j);                    \
+}                                                  \
+while (0);
+
+#define pbkIsBintEqualToZero(pbi) (1 == GETABS(GETFLAG(pbi)) && !(*(pbi)->data))
+
+/* Thresholds used by the kernel. They can be altered at runtime before any computation. */
+extern PBKTUNE gTuneTable;
+
+/* Functions for big integers. */
+bool   pbkInitBint       (P_BINT pbi, _ib  i);
+bool   pbkReallocBint    (P_BINT pbi, _ub  size, bool binc);
+void   pbkFreeBint       (P_BINT pbi);
+P_BINT pbkCreateBint     (_ib    i);
+void   pbkDeleteBint     (P_BINT pbi);
+bool   pbkMoveBint       (P_BINT a, P_BINT b);
+P_BINT pbkCopyBint       (P_BINT a);
+bool   pbkIbToBint       (P_BINT a, _ib    i);
+_ib    pbkBintToIb       (P_BINT a);
+int    pbkCompareBint    (P_BINT a, P_BINT b);
+bool   pbkAddBint        (P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkSubtractBint   (P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkLeftShiftBint  (P_BINT a, _ub    blocks, _ub    bits);
+bool   pbkRightShiftBint (P_BINT a, _ub    blocks, _ub    bits);
+bool   pbkMultiplyBintOld(P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkMultiplyBintNew(P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkMultiplyBintFFT(P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkMultiplyBint   (P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkMulLowBint     (P_BINT c, P_BINT a,    P_BINT   b, _ub blocks);
+bool   pbkMulHighBint    (P_BINT c, P_BINT a,    P_BINT   b);
+bool   pbkDivideBint     (P_BINT q, P_BINT r,    P_BINT   a, P_BINT b);
+bool   pbkDivideExactBint(P_BINT q, P_BINT a,    P_BINT   b);
+bool   pbkModBint        (P_BINT r, P_BINT a,    P_BINT   b);
+bool   pbkDivBint        (P_BINT q, P_BINT a,    P_BINT   b);
+/* Functions for transformed big integers. */
+bool   pbkInitTbint      (P_TBINT pt, P_BINT a,  _ub      blocks);
+void   pbkFreeTbint      (P_TBINT pt);
+bool   pbkMultiplyTbint  (P_BINT  c,  P_TBINT a, P_BINT   b);
+bool   pbkSquareTbint    (P_BINT  c,  P_TBINT a);
+/* Functions for big numbers. */
+bool   pbkInitBnum         (P_BNUM pbn, _ub    base);
+bool   pbkReallocBnum      (P_BNUM pbn, _ub    size, bool binc);
+void   pbkFreeBnum         (P_BNUM pbn);
+P_BNUM pbkCreateBnum       (_ub    base);
+void   pbkDeleteBnum       (P_BNUM pbn);
+bool   pbkMoveBnum         (P_BNUM a,   P_BNUM b);
+bool   pbkIbToBnum         (P_BNUM pbn, _ib    n);
+bool   pbkDecimalSzToBnum  (P_BNUM pbn, const char * str);
+void   pbkPrintBnum        (P_BNUM pbn);
+bool   pbkAddBnum          (P_BNUM c,   P_BNUM a, P_BNUM b);
+bool   pbkSubtractBnum     (P_BNUM c,   P_BNUM a, P_BNUM b);
+bool   pbkMultiplyBnum1    (P_BNUM c,   P_BNUM a, _ub    b);
+bool   pbkMultiplyBnum     (P_BNUM c,   P_BNUM a, P_BNUM b);
+bool   pbkBintToBnum       (P_BNUM x,   P_BINT a);
+bool   pbkBintToDecimalBnum(P_BNUM x,   P_BINT a);
+char * pbkBintToSz         (P_BINT a,   _ub    base);
+char * pbkBintToDecimalSz  (P_BINT a);
+size_t pbkBintSzLength     (P_BINT a,   _ub    base, bool bexact);
+size_t pbkBintToSzN        (char * str, size_t size, P_BINT a, _ub base);
+bool   pbkBintToStream     (P_BINT a,   _ub    base, CBF_PBKWRITE cbf, void * param);
+bool   pbkBnumToBint       (P_BINT x,   P_BNUM a);
+bool   pbkDecimalBnumToBint(P_BINT x,   P_BNUM a);
+bool   pbkSzToBint         (P_BINT x,   const char * str, _ub base);
+bool   pbkSzNToBint        (P_BINT x,   const char * str, size_t n, _ub base);
+bool   pbkPreparePowers    (_ub    base, size_t digits);
+bool   pbkGetPower         (P_PBKPOWER pp, _ub base, size_t i);
+bool   pbkPutPower         (_ub    base, size_t i, P_PBKPOWER pp);
+void   pbkFreePowers       (void);
+bool   pbkDecimalSzToBint  (P_BINT x,   const char * str);
+
+#endif
+
@@ -1,765 +1,1715 @@
-/*
- * Name:        pbm.c
- * Description: Portable big integer library mathematics module.
- * Author:      cosh.cage#hotmail.com
- * File ID:     0520240323D0225262300L00765
- * License:     GPLv3.
- */
-
-#include "pbm.h"
-#include <stdlib.h>
-
-#define RAND_1_TIME(start, end) ((start) + rand() / (((_udb)RAND_MAX + 1) / (end)))
-
-#define PTSIZ 169
-unsigned short gPrimeTable1K[PTSIZ] =
-{
-	  0,   2,   3,   5,   7,  11,  13,  17,  19,  23,
-	 29,  31,  37,  41,  43,  47,  53,  59,  61,  67,
-	 71,  73,  79,  83,  89,  97, 101, 103, 107, 109,
-	113, 127, 131, 137, 139, 149, 151, 157, 163, 167,
-	173, 179, 181, 191, 193, 197, 199, 211, 223, 227,
-	229, 233, 239, 241, 251, 257, 263, 269, 271, 277,
-	281, 283, 293, 307, 311, 313, 317, 331, 337, 347,
-	349, 353, 359, 367, 373, 379, 383, 389, 397, 401,
-	409, 419, 421, 431, 433, 439, 443, 449, 457, 461,
-	463, 467, 479, 487, 491, 499, 503, 509, 521, 523,
-	541, 547, 557, 563, 569, 571, 577, 587, 593, 599,
-	601, 607, 613, 617, 619, 631, 641, 643, 647, 653,
-	659, 661, 673, 677, 683, 691, 701, 709, 719, 727,
-	733, 739, 743, 751, 757, 761, 769, 773, 787, 797,
-	809, 811, 821, 823, 827, 829, 839, 853, 857, 859,
-	863, 877, 881, 883, 887, 907, 911, 919, 929, 937,
-	941, 947, 953, 967, 971, 977, 983, 991, 997
-};
-
-/* File level function declaration. */
-_ub      _pbmRand1Block    (void);
-bool _pbkIsPrimePrimary(P_BINT n);
-
-/* Function name: pbmBintPower
- * Description:   Calculates the power of a big integer.
- * Parameters:
- *          r Pointer to a big integer that is the result.
- *          a Pointer to a big integer.
- *          n Power of n.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           r := a ^ n; (r := power(a, n);)
- *                This function uses quick power algorithm.
- */
-bool pbmBintPower(P_BINT r, P_BINT a, _ub n)
-{
-	BINT A = { 0 }, T = { 0 }, R = { 0 };
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(r))
-		return false;
-	else
-	{
-		SETFLAG(r, 1);
-		r->data[0] = 1;
-
-		pbkInitBint(&R, 0);
-		pbkInitBint(&T, 0);
-		pbkMoveBint(&A, a);
-
-		while (n)
-		{
-			if (n & 1)
-			{
-				if (!pbkMoveBint(&R, r))
-					goto Lbl_Failed;
-				if (!pbkMultiplyBint(r, &R, &A))
-					goto Lbl_Failed;
-			}
-
-			if (!pbkMultiplyBint(&T, &A, &A))
-				goto Lbl_Failed;
-
-			if (!pbkMoveBint(&A, &T))
-				goto Lbl_Failed;
-
-			n >>= 1;
-		}
-
-		pbkFreeBint(&A);
-		pbkFreeBint(&T);
-		pbkFreeBint(&R);
-
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&A);
-	pbkFreeBint(&T);
-	pbkFreeBint(&R);
-
-	return false;
-}
-
-/* Function name: pbmBintPowerBint
- * Description:   Calculates the power of a big integer.
- * Parameters:
- *          r Pointer to a big integer that is the result.
- *          a Pointer to a big integer.
- *          n Power of n.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       Big integer parameter n will change to value zero after invoking.
- * Tip:           r := a ^ n; (r := power(a, n);)
- *                This function uses quick power algorithm.
- */
-bool pbmBintPowerBint(P_BINT r, P_BINT a, P_BINT n)
-{
-	BINT A = { 0 }, T = { 0 }, R = { 0 };
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(r))
-		return false;
-	else
-	{
-		SETFLAG(r, 1);
-		r->data[0] = 1;
-
-		pbkInitBint(&R, 0);
-		pbkInitBint(&T, 0);
-		pbkMoveBint(&A, a);
-
-		while (! pbkIsBintEqualToZero(n))
-		{
-			if (n->data[0] & 1)
-			{
-				if (!pbkMoveBint(&R, r))
-					goto Lbl_Failed;
-				if (!pbkMultiplyBint(r, &R, &A))
-					goto Lbl_Failed;
-			}
-
-			if (!pbkMultiplyBint(&T, &A, &A))
-				goto Lbl_Failed;
-
-			if (!pbkMoveBint(&A, &T))
-				goto Lbl_Failed;
-
-			if (!pbkRightShiftBint(n, 0, 1))
-				goto Lbl_Failed;
-		}
-
-		pbkFreeBint(&A);
-		pbkFreeBint(&T);
-		pbkFreeBint(&R);
-
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&A);
-	pbkFreeBint(&T);
-	pbkFreeBint(&R);
-
-	return false;
-}
-
-/* Function name: pbmBintExponentialModule
- * Description:   Calculates exp mod.
- * Parameters:
- *          r Pointer to a big integer that is the result.
- *          a Pointer to a big integer.
- *          n Power of n.
- *          m Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           r := a ^ n mod m.
- *                This function uses quick power algorithm.
- */
-bool pbmBintExponentialModule(P_BINT r, P_BINT a, _ub n, P_BINT m)
-{
-	BINT R = { 0 }, T = { 0 };
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(m))
-		return false;
-	else
-	{
-		pbkInitBint(&R, 0);
-		pbkInitBint(&T, 0);
-
-		pbkDivideBint(NULL, &R, a, m);
-		pbkMoveBint(a, &R);
-
-		SETFLAG(r, 1);
-		r->data[0] = 1;
-
-		while (n)
-		{
-			if (n & 1)
-			{
-				if (!pbkMultiplyBint(&R, r, a))
-					goto Lbl_Failed;
-				if (!pbkDivideBint(NULL, &T, &R, m))
-					goto Lbl_Failed;
-				if (!pbkMoveBint(r, &T))
-					goto Lbl_Failed;
-			}
-
-			if (!pbkMultiplyBint(&T, a, a))
-				goto Lbl_Failed;
-			if (!pbkDivideBint(NULL, a, &T, m))
-				goto Lbl_Failed;
-
-			n >>= 1;
-		}
-
-		pbkFreeBint(&R);
-		pbkFreeBint(&T);
-
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&R);
-	pbkFreeBint(&T);
-
-	return false;
-}
-
-/* Function name: pbmBintExponentialModuleBint
- * Description:   Calculates exp mod.
- * Parameters:
- *          r Pointer to a big integer that is the result.
- *          a Pointer to a big integer.
- *          n Power of n.
- *          m Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           r := a ^ n mod m.
- *                This function uses quick power algorithm.
- * Caution:       n will change after invoking,
- */
-bool pbmBintExponentialModuleBint(P_BINT r, P_BINT a, P_BINT n, P_BINT m)
-{
-	long i = 1;
-	BINT R = { 0 }, T = { 0 };
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(m))
-		return false;
-	else
-	{
-		pbkInitBint(&R, 0);
-		pbkInitBint(&T, 0);
-
-		pbkDivideBint(NULL, &T, a, m);
-		pbkMoveBint(a, &T);
-
-		SETFLAG(r, 1);
-		r->data[0] = 1;
-
-		while (! pbkIsBintEqualToZero(n))
-		{
-			if (n->data[0] & 1)
-			{
-				if (!pbkMultiplyBint(&R, r, a))
-					goto Lbl_Failed;
-				if (!pbkDivideBint(NULL, &T, &R, m))
-					goto Lbl_Failed;
-				if (!pbkMoveBint(r, &T))
-					goto Lbl_Failed;
-			}
-
-			if (!pbkMultiplyBint(&T, a, a))
-				goto Lbl_Failed;
-			if (!pbkDivideBint(NULL, a, &T, m))
-				goto Lbl_Failed;
-			if (!pbkRightShiftBint(n, 0, 1))
-				goto Lbl_Failed;
-		}
-
-		pbkFreeBint(&R);
-		pbkFreeBint(&T);
-
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&R);
-	pbkFreeBint(&T);
-
-	return false;
-}
-
-/* Function name: pbmUbFactorial
- * Description:   Factorial of an integer.
- * Parameters:
- *          r Pointer to a big integer to store the result.
- *          n fact(n).
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Tip:           Big value of n is slow to solve.
- */
-bool pbmUbFactorial(P_BINT r, _ub n)
-{
-	BINT R = { 0 }, N = { 0 };
-
-	pbkInitBint(&R, 0);
-	pbkInitBint(&N, 0);
-
-	SETFLAG(r, 1);
-	r->data[0] = 1;
-
-	SETFLAG(&N, 1);
-
-	while (n - 1)
-	{
-		if (!pbkMoveBint(&R, r))
-		{
-			pbkFreeBint(&R);
-			pbkFreeBint(&N);
-			return false;
-		}
-		N.data[0] = n;
-		if (!pbkMultiplyBint(r, &N, &R))
-		{
-			pbkFreeBint(&R);
-			pbkFreeBint(&N);
-			return false;
-		}
-		--n;
-	}
-
-	pbkFreeBint(&R);
-	pbkFreeBint(&N);
-	return true;
-}
-
-/* Function name: pbmBintSquareRoot
- * Description:   Gets the square root of a big integer.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *          n sqrt(n).
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool pbmBintSquareRoot(P_BINT r, P_BINT n)
-{
-	BINT * xk = r, XK1 = { 0 }, T = { 0 }, X = { 0 };
-	if (pbkIsNotANumber(n))
-		return false;
-	else
-	{
-		pbkInitBint(&T, 0);
-		pbkInitBint(&X, 0);
-		pbkMoveBint(&XK1, n);
-
-		do
-		{
-			if (!pbkMoveBint(xk, &XK1))
-				goto Lbl_Failure;
-			if (!pbkDivideBint(&X, &T, n, xk))
-				goto Lbl_Failure;
-			if (!pbkAddBint(&XK1, &X, xk))
-				goto Lbl_Failure;
-			if (!pbkRightShiftBint(&XK1, 0, 1))
-				goto Lbl_Failure;
-		}
-		while (pbkCompareBint(&XK1, xk) < 0);
-		pbkFreeBint(&XK1);
-		pbkFreeBint(&T);
-		pbkFreeBint(&X);
-		return true;
-	}
-Lbl_Failure:
-	pbkFreeBint(&XK1);
-	pbkFreeBint(&T);
-	pbkFreeBint(&X);
-	return false;
-}
-
-/* Function name: pbmBintKthRoot
- * Description:   Gets the kth root of the big integer m.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *          m Pointer to a big integer.
- *          k m^(1/k).
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       k must >= 2.
- */
-bool pbmBintKthRoot(P_BINT r, P_BINT m, _ub k)
-{
-	BINT U = { 0 }, X = { 0 }, Y = { 0 }, Z = { 0 };
-	
-	if (k < 2)
-		return false;
-	
-	if (pbkIsNotANumber(m) || pbkIsNotANumber(r))
-		return false;
-	else
-	{
-		pbkInitBint(&X, 0);
-		pbkInitBint(&Y, 0);
-		pbkInitBint(&Z, 0);
-		
-		pbkInitBint(&U, 0);
-		pbkMoveBint(&U, m);
-		
-		do
-		{	
-			pbkMoveBint(r, &U);
-			
-			pbmBintPower(&X, r, k - 1);
-			
-			pbkDivideBint(&Y, NULL, m, &X);
-			
-			Z.data[0] = k - 1;
-			SETFLAG(&Z, 1);
-			
-			pbkMultiplyBint(&X, r, &Z);
-			
-			pbkAddBint(&Z, &X, &Y);
-			
-			pbkIbToBint(&X, (_ib)k);
-			
-			pbkDivideBint(&U, NULL, &Z, &X);
-		}
-		while (pbkCompareBint(&U, r) < 0);
-		
-		pbkFreeBint(&U);
-		pbkFreeBint(&X);
-		pbkFreeBint(&Y);
-		pbkFreeBint(&Z);
-		
-		return true;
-	}
-	return false;
-}
-
-/* Function name: pbmBintKthRootBint
- * Description:   Gets the big integer kth root of the big integer m.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *          m Pointer to a big integer.
- *          k m^(1/k).
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       k must >= 2.
- */
-bool pbmBintKthRootBint(P_BINT r, P_BINT m, P_BINT k)
-{
-	BINT U = { 0 }, X = { 0 }, Y = { 0 }, Z = { 0 }, T = { 0 }, I = { 0 };
-	if (pbkIsNotANumber(r) || pbkIsNotANumber(m) || pbkIsNotANumber(k))
-		return false;
-	else
-	{
-		pbkInitBint(&X, 2);
-		
-		if (pbkCompareBint(k, &X) < 0)
-		{
-			pbkFreeBint(&X);
-			return false;
-		}
-		
-		pbkInitBint(&Y, 0);
-		pbkInitBint(&Z, 0);
-		pbkInitBint(&T, 0);
-		pbkInitBint(&I, 1);
-		
-		pbkInitBint(&U, 0);
-		pbkMoveBint(&U, m);
-		
-		do
-		{	
-			pbkMoveBint(r, &U);
-			
-			pbkSubtractBint(&T, k, &I);
-			
-			pbmBintPowerBint(&X, r, &T);
-			
-			pbkDivideBint(&Y, NULL, m, &X);
-			
-			pbkSubtractBint(&T, k, &I);
-			
-			pbkMultiplyBint(&X, r, &T);
-			
-			pbkAddBint(&Z, &X, &Y);
-			
-			pbkDivideBint(&U, NULL, &Z, k);
-		}
-		while (pbkCompareBint(&U, r) < 0);
-		
-		pbkFreeBint(&U);
-		pbkFreeBint(&X);
-		pbkFreeBint(&Y);
-		pbkFreeBint(&Z);
-		pbkFreeBint(&T);
-		pbkFreeBint(&I);
-		
-		return true;
-	}
-	return false;
-}
-
-/* Function name: pbmBintGreatestCommonDivisor
- * Description:   Gets the greatest common divisor of two big integers.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- * Caution:       After invoking, the value of a and b are both CHANGED!
- * Tip:           This function uses Euclidian algorithm.
- */
-bool pbmBintGreatestCommonDivisor(P_BINT r, P_BINT a, P_BINT b)
-{
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsNotANumber(r))
-		return false;
-	else
-	{
-		while (!pbkIsBintEqualToZero(b))
-		{
-			if (!pbkDivideBint(NULL, r, a, b))
-				goto Lbl_Failed;
-
-			if (!pbkMoveBint(a, b))
-				goto Lbl_Failed;
-
-			if (!pbkMoveBint(b, r))
-				goto Lbl_Failed;
-		}
-		if (!pbkMoveBint(r, a))
-			goto Lbl_Failed;
-
-		return true;
-	}
-Lbl_Failed:
-	return false;
-}
-
-/* Function name: pbmBintLeastCommonMultiple
- * Description:   Gets the least common multiple of two big integers.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *          a Pointer to a big integer.
- *          b Pointer to a big integer.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool pbmBintLeastCommonMultiple(P_BINT r, P_BINT a, P_BINT b)
-{
-	BINT T = {0}, U = {0};
-	
-	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsNotANumber(r))
-		return false;
-	else
-	{
-		pbkInitBint(&T, 0);
-		pbkInitBint(&U, 0);
-		
-		if (!pbkMultiplyBint(&U, a, b))
-			goto Lbl_Failed;
-		
-		if (!pbmBintGreatestCommonDivisor(&T, a, b))
-			goto Lbl_Failed;
-		
-		if (!pbkIsBintEqualToZero(&T))
-		{
-			if (!pbkDivideBint(r, NULL, &U, &T))
-				goto Lbl_Failed;
-		}
-		else
-			goto Lbl_Failed;
-		
-		pbkFreeBint(&T);
-		pbkFreeBint(&U);
-		return true;
-	}
-Lbl_Failed:
-	pbkFreeBint(&T);
-	pbkFreeBint(&U);
-	return false;
-}
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _pbmRand1Block
- * Description:   Generate 1 block random number.
- * Parameters:    N/A.
- * Return value:  Random number.
- */
-_ub _pbmRand1Block(void)
-{
-	register _udb u = 1;
-	register _ub v = 1;
-	register size_t i, j = 0;
-	while (!(u >> UB_BIT))
-	{
-		u *= RAND_MAX;
-		++j;
-	}
-	for (i = 0; i < j; ++i)
-		v *= rand();
-	return v;
-}
-
-/* Function name: pbmRandomGenerator
- * Description:   An RNG.
- * Parameters:
- *          r Pointer to a big integer to store result.
- *     blocks Maximum number of blocks to be generate.
- *     blarge false Generate a smaller integer than blocks.
- *            true  Generate a larger integer than blocks - 1.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool pbmRandomGenerator(P_BINT r, _ub blocks, bool blarge)
-{
-	size_t i = RAND_1_TIME(1, blocks), j;
-	if (!pbkReallocBint(r, (_ub)i, false))
-		return false;
-	for (j = 0; j < blarge ? i : i - 1; ++j)
-		r->data[j] = _pbmRand1Block();
-	pbkShrinkZeroFlag(r);
-	return true;
-}
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _pbkIsPrimePrimary
- * Description:   Test prime number.
- * Parameter:
- *         n Pointer to a big integer to be tested.
- * Return value:  true:  Succeeded.
- *                false: Failed.
- */
-bool _pbkIsPrimePrimary(P_BINT n)
-{
-	size_t i;
-	bool r = true;
-
-	BINT P = { 0 }, R = { 0 };
-
-	pbkInitBint(&P, 0);
-
-	for (i = 1; i < PTSIZ; ++i)
-	{
-		P.data[0] = gPrimeTable1K[i];
-		pbkDivideBint(NULL, &R, n, &P);
-		if (pbkIsBintEqualToZero(&R))
-		{
-			r = false;
-			goto Lbl_Finish;
-		}
-	}
-
-Lbl_Finish:
-	pbkFreeBint(&P);
-	return r;
-}
-
-/* Function name: pbmMillerRabinTest
- * Description:   Miller Rabin primality test.
- * Parameters:
- *          r Pointer to a big integer to be tested.
- *          k K times of evaluation. K should be greater than 8.
- * Return value:  true:  n is a pseudo prime.
- *                false: n is NOT a prime.
- */
-bool pbmMillerRabinTest(P_BINT n, _ub k)
-{
-	BINT A = { 0 }, X = { 0 }, N_1 = { 0 }, U = { 0 }, V = { 0 }, T = { 0 };
-	bool r = true;
-	_udb t = 0, s;
-	size_t i;
-	if ((pbkBintToIb(n) < 3) || 0 == (pbkBintToIb(n) & 1))
-	{
-		if (2 == pbkBintToIb(n) && 1 == GETFLAG(n))
-			return true;
-		else
-			return false;
-	}
-	else
-	{
-		if (false == _pbkIsPrimePrimary(n))
-			return false;
-
-		pbkInitBint(&A, 0);
-		pbkInitBint(&X, 1);
-		pbkInitBint(&N_1, 0);
-		pbkInitBint(&V, 0);
-		pbkInitBint(&T, 0);
-
-		if (!pbkSubtractBint(&N_1, n, &X))
-		{
-			r = false;
-			goto Lbl_Finish;
-		}
-
-		if (!pbkMoveBint(&U, &N_1))
-		{
-			r = false;
-			goto Lbl_Finish;
-		}
-
-		while (0 == (U.data[0] & 1))
-		{
-			pbkRightShiftBint(&U, 0, 1);
-			++t;
-		}
-
-		for (i = 0; i < k; ++i)
-		{
-			if (GETFLAG(n) > 1)
-			{
-				if (!pbmRandomGenerator(&A, GETABS(GETFLAG(n)) - 1, true))
-				{
-					r = false;
-					goto Lbl_Finish;
-				}
-			}
-			else
-			{
-				if (!pbmRandomGenerator(&A, 1, false))
-				{
-					r = false;
-					goto Lbl_Finish;
-				}
-			}
-
-			if (!pbkMoveBint(&T, &U))
-			{
-				r = false;
-				goto Lbl_Finish;
-			}
-			
-			if (!pbmBintExponentialModuleBint(&V, &A, &T, n))
-			{
-				r = false;
-				goto Lbl_Finish;
-			}
-
-			if (1 == GETFLAG(&V) && 1 == V.data[0])
-				continue;
-
-			for (s = 0; s < t; ++s)
-			{
-				if (0 == pbkCompareBint(&V, &N_1))
-					break;
-
-				if (!pbmBintExponentialModule(&X, &V, 2, n))
-				{
-					r = false;
-					goto Lbl_Finish;
-				}
-
-				if (!pbkMoveBint(&V, &X))
-				{
-					r = false;
-					goto Lbl_Finish;
-				}
-			}
-			if (s == t)
-			{
-				r = false;
-				goto Lbl_Finish;
-			}
-		}
-		r = true;
-	}
-Lbl_Finish:
-	pbkFreeBint(&A);
-	pbkFreeBint(&X);
-	pbkFreeBint(&N_1);
-	pbkFreeBint(&U);
-	pbkFreeBint(&V);
-	pbkFreeBint(&T);
-	return r;
-}
-
+/*
+ * Name:        pbm.c
+ * Description: Portable big integer library mathematics module.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     0520240323D1019261820L01715
+ * License:     GPLv3.
+ */
+
+#include "pbm.h"
+#include "pbb.h"
+#include <stdlib.h>
+#include <string.h> /* Using function memcpy, memset. */
+
+#define RAND_1_TIME(start, end) ((start) + rand() / (((_udb)RAND_MAX + 1) / (end)))
+
+/* Bit i of a block array. */
+#define _PBM_BIT(e, i) (((e)[(i) / UB_BIT] >> ((i) % UB_BIT)) & 1)
+
+/* Whether a big integer is an odd number greater than 1, so that Montgomery's method applies. */
+#define _PBM_IS_MONT(pbi) (GETFLAG(pbi) > 0 && ((pbi)->data[0] & 1) && !(1 == GETFLAG(pbi) && 1 == (pbi)->data[0]))
+
+#define PTSIZ 169
+unsigned short gPrimeTable1K[PTSIZ] =
+{
+	  0,   2,   3,   5,   7,  11,  13,  17,  19,  23,
+	 29,  31,  37,  41,  43,  47,  53,  59,  61,  67,
+	 71,  73,  79,  83,  89,  97, 101, 103, 107, 109,
+	113, 127, 131, 137, 139, 149, 151, 157, 163, 167,
+	173, 179, 181, 191, 193, 197, 199, 211, 223, 227,
+	229, 233, 239, 241, 251, 257, 263, 269, 271, 277,
+	281, 283, 293, 307, 311, 313, 317, 331, 337, 347,
+	349, 353, 359, 367, 373, 379, 383, 389, 397, 401,
+	409, 419, 421, 431, 433, 439, 443, 449, 457, 461,
+	463, 467, 479, 487, 491, 499, 503, 509, 521, 523,
+	541, 547, 557, 563, 569, 571, 577, 587, 593, 599,
+	601, 607, 613, 617, 619, 631, 641, 643, 647, 653,
+	659, 661, 673, 677, 683, 691, 701, 709, 719, 727,
+	733, 739, 743, 751, 757, 761, 769, 773, 787, 797,
+	809, 811, 821, 823, 827, 829, 839, 853, 857, 859,
+	863, 877, 881, 883, 887, 907, 911, 919, 929, 937,
+	941, 947, 953, 967, 971, 977, 983, 991, 997
+};
+
+/* File level function declaration. */
+_ub      _pbmRand1Block    (void);
+bool _pbkIsPrimePrimary(P_BINT n);
+static bool _pbmMontLoad       (const PBMMONT * pm, _ub * x, P_BINT a);
+static bool _pbmStoreBlocks    (P_BINT r, const _ub * x, size_t n);
+static bool _pbmMontMultiply   (const PBMMONT * pm, _ub * c, const _ub * a, const _ub * b, _ub * t);
+static bool _pbmMontExponential(const PBMMONT * pm, P_BINT r, P_BINT a, const _ub * e, size_t le);
+static bool _pbmBarrettReduce  (const PBMBARRETT * pb, _ub * r, _ub * t, _ub * w);
+static bool _pbmBarrettLoad    (const PBMBARRETT * pb, _ub * x, P_BINT a, _ub * t, _ub * w);
+static bool _pbmBarrettMultiply(const PBMBARRETT * pb, _ub * c, const _ub * a, const _ub * b, _ub * t);
+static bool _pbmBarrettExponential(const PBMBARRETT * pb, P_BINT r, P_BINT a, const _ub * e, size_t le);
+static bool _pbmPower          (P_BINT r, P_BINT a, const _ub * e, size_t le);
+static size_t _pbmWindowBits   (size_t bits);
+static bool _pbmMulMod         (const PBMMONT * pm, const PBMBARRETT * pb, _ub * c, const _ub * a, const _ub * b, _ub * t);
+static bool _pbmWindowPower    (const PBMMONT * pm, const PBMBARRETT * pb, _ub * x, const _ub * g, const _ub * e, size_t le);
+static bool _pbmLoadMod        (const PBMMONT * pm, const PBMBARRETT * pb, _ub * x, P_BINT a, _ub * t);
+static bool _pbmStoreMod       (const PBMMONT * pm, const PBMBARRETT * pb, P_BINT r, _ub * x, _ub * t);
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmPower
+ * Description:   Calculates the power of a big integer.
+ * Parameters:
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          e Pointer to the exponent of le blocks.
+ *         le Number of blocks of e.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a ^ e; r may equal to a.
+ *                Bits of e are read from the highest one without changing e, so that
+ *                each step squares the result and at most multiplies it by a.
+ */
+static bool _pbmPower(P_BINT r, P_BINT a, const _ub * e, size_t le)
+{
+	BINT X = { 0 }, T = { 0 }, S;
+	register size_t i;
+	bool bok = false;
+
+	while (le > 0 && 0 == e[le - 1])
+		--le;
+	if (0 == le)
+		return pbkIbToBint(r, 1);
+
+	if (!pbkInitBint(&T, 0) || !pbkMoveBint(&X, a))
+		goto Lbl_Finish;
+
+	for (i = (le - 1) * UB_BIT + UB_BIT - 1; !_PBM_BIT(e, i); --i)
+		;
+	while (i-- > 0)
+	{
+		if (!pbkMultiplyBint(&T, &X, &X))
+			goto Lbl_Finish;
+		if (_PBM_BIT(e, i))
+		{
+			if (!pbkMultiplyBint(&X, &T, a))
+				goto Lbl_Finish;
+		}
+		else
+		{
+			S = X;
+			X = T;
+			T = S;
+		}
+	}
+	bok = pbkMoveBint(r, &X);
+Lbl_Finish:
+	pbkFreeBint(&X);
+	pbkFreeBint(&T);
+	return bok;
+}
+
+/* Function name: pbmBintPower
+ * Description:   Calculates the power of a big integer.
+ * Parameters:
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a ^ n; (r := power(a, n);)
+ *                This function uses quick power algorithm, see _pbmPower.
+ */
+bool pbmBintPower(P_BINT r, P_BINT a, _ub n)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(r))
+		return false;
+	return _pbmPower(r, a, &n, 1);
+}
+
+/* Function name: pbmBintPowerBint
+ * Description:   Calculates the power of a big integer.
+ * Parameters:
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The sign of n is ignored.
+ * Tip:           r := a ^ n; (r := power(a, n);)
+ *                This function uses quick power algorithm, see _pbmPower.
+ *                Neither a nor n is changed.
+ */
+bool pbmBintPowerBint(P_BINT r, P_BINT a, P_BINT n)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(r) || pbkIsNotANumber(n))
+		return false;
+	return _pbmPower(r, a, n->data, GETABS(GETFLAG(n)));
+}
+
+/* Function name: pbmBintExponentialModule
+ * Description:   Calculates exp mod.
+ * Parameters:
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ *          m Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       m shall not be 0. The sign of m is ignored.
+ * Tip:           r := a ^ n mod m; 0 <= r < |m|.
+ *                This function uses sliding window exponentiation. Neither a nor m is changed.
+ *                If m is an odd number greater than 1, products are reduced by
+ *                Montgomery's method, see pbmMontgomeryExponential. Otherwise they
+ *                are reduced by Barrett's method, see pbmBarrettExponential.
+ */
+bool pbmBintExponentialModule(P_BINT r, P_BINT a, _ub n, P_BINT m)
+{
+	bool bok;
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(m))
+		return false;
+	else if (_PBM_IS_MONT(m))
+	{
+		PBMMONT mt;
+
+		if (!pbmInitMontgomery(&mt, m))
+			return false;
+		bok = _pbmMontExponential(&mt, r, a, &n, 1);
+		pbmFreeMontgomery(&mt);
+	}
+	else
+	{
+		PBMBARRETT br;
+
+		if (!pbmInitBarrett(&br, m))
+			return false;
+		bok = _pbmBarrettExponential(&br, r, a, &n, 1);
+		pbmFreeBarrett(&br);
+	}
+	return bok;
+}
+
+/* Function name: pbmBintExponentialModuleBint
+ * Description:   Calculates exp mod.
+ * Parameters:
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ *          m Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a ^ n mod m; 0 <= r < |m|.
+ *                This function uses sliding window exponentiation. Neither a, n nor m is changed.
+ *                If m is an odd number greater than 1, products are reduced by
+ *                Montgomery's method, see pbmMontgomeryExponential. Otherwise they
+ *                are reduced by Barrett's method, see pbmBarrettExponential.
+ * Caution:       m shall not be 0. The signs of n and m are ignored.
+ */
+bool pbmBintExponentialModuleBint(P_BINT r, P_BINT a, P_BINT n, P_BINT m)
+{
+	bool bok;
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(n) || pbkIsNotANumber(m))
+		return false;
+	else if (_PBM_IS_MONT(m))
+	{
+		PBMMONT mt;
+
+		if (!pbmInitMontgomery(&mt, m))
+			return false;
+		bok = _pbmMontExponential(&mt, r, a, n->data, GETABS(GETFLAG(n)));
+		pbmFreeMontgomery(&mt);
+	}
+	else
+	{
+		PBMBARRETT br;
+
+		if (!pbmInitBarrett(&br, m))
+			return false;
+		bok = _pbmBarrettExponential(&br, r, a, n->data, GETABS(GETFLAG(n)));
+		pbmFreeBarrett(&br);
+	}
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmMulMod
+ * Description:   Multiplies two block arrays in a Montgomery or Barrett context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context or NULL.
+ *         pb Pointer to a Barrett context if pm is NULL.
+ *          c Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a block array of n blocks in the form of the context.
+ *          b Pointer to a block array of n blocks in the form of the context.
+ *          t Pointer to 4 * n + 3 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           c may equal to a or b. Pass a twice to square.
+ */
+static bool _pbmMulMod(const PBMMONT * pm, const PBMBARRETT * pb, _ub * c, const _ub * a, const _ub * b, _ub * t)
+{
+	return NULL != pm ? _pbmMontMultiply(pm, c, a, b, t) : _pbmBarrettMultiply(pb, c, a, b, t);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmWindowBits
+ * Description:   Choose the window size of exponentiation.
+ * Parameter:
+ *       bits Bits of the exponent.
+ * Return value:  Bits of each window.
+ * Tip:           A window of k bits costs 2 ^ (k - 1) multiplications for the table
+ *                of odd powers and saves about bits / (k + 1) multiplications.
+ */
+static size_t _pbmWindowBits(size_t bits)
+{
+	if (bits > 671)
+		return 6;
+	else if (bits > 239)
+		return 5;
+	else if (bits > 79)
+		return 4;
+	else if (bits > 23)
+		return 3;
+	return 1;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmWindowPower
+ * Description:   Sliding window exponentiation in a Montgomery or Barrett context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context or NULL.
+ *         pb Pointer to a Barrett context if pm is NULL.
+ *          x Pointer to a block array of n blocks to store the result.
+ *          g Pointer to the base of n blocks in the form of the context. x != g.
+ *          e Pointer to the exponent of le blocks.
+ *         le Number of blocks of e. The highest block of e shall not be 0.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           x := g ^ e.
+ *                Bits of e are scanned in place from the highest one. Zero bits cost a
+ *                square each. Otherwise the longest window of at most k bits that ends
+ *                with 1 is taken, and the window value, which is odd, picks one of the
+ *                precomputed powers g, g ^ 3, ..., g ^ (2 ^ k - 1).
+ */
+static bool _pbmWindowPower(const PBMMONT * pm, const PBMBARRETT * pb, _ub * x, const _ub * g, const _ub * e, size_t le)
+{
+	register size_t i, j, l, n = NULL != pm ? pm->n : pb->n;
+	register size_t k, w;
+	_ub * tbl, * t;
+	bool bok = false, bfirst = true;
+
+	for (i = (le - 1) * UB_BIT + UB_BIT - 1; !_PBM_BIT(e, i); --i)
+		;
+	k = _pbmWindowBits(i + 1);
+
+	/* Table of 2 ^ (k - 1) odd powers and 4 * n + 3 scratch blocks. */
+	if (NULL == (tbl = (_ub *)malloc((((size_t)1 << (k - 1)) * n + 4 * n + 3) * sizeof(_ub))))
+		return false;
+	t = tbl + ((size_t)1 << (k - 1)) * n;
+
+	memcpy(tbl, g, n * sizeof(_ub));
+	if (k > 1)
+	{
+		if (!_pbmMulMod(pm, pb, x, g, g, t))
+			goto Lbl_Finish;
+		for (j = 1; j < ((size_t)1 << (k - 1)); ++j)
+			if (!_pbmMulMod(pm, pb, tbl + j * n, tbl + (j - 1) * n, x, t))
+				goto Lbl_Finish;
+	}
+
+	for (;;)
+	{
+		if (!_PBM_BIT(e, i))
+		{
+			if (!_pbmMulMod(pm, pb, x, x, x, t))
+				goto Lbl_Finish;
+		}
+		else
+		{
+			/* Window of bits i down to l. */
+			for (l = i + 1 >= k ? i + 1 - k : 0; !_PBM_BIT(e, l); ++l)
+				;
+			for (w = 0, j = i + 1; j > l; --j)
+				w = (w << 1) | _PBM_BIT(e, j - 1);
+
+			if (bfirst)
+			{
+				memcpy(x, tbl + (w >> 1) * n, n * sizeof(_ub));
+				bfirst = false;
+			}
+			else
+			{
+				for (j = l; j <= i; ++j)
+					if (!_pbmMulMod(pm, pb, x, x, x, t))
+						goto Lbl_Finish;
+				if (!_pbmMulMod(pm, pb, x, x, tbl + (w >> 1) * n, t))
+					goto Lbl_Finish;
+			}
+			i = l;
+		}
+		if (0 == i--)
+			break;
+	}
+	bok = true;
+Lbl_Finish:
+	free(tbl);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmMontLoad
+ * Description:   Reduce a big integer by the modulus of a Montgomery context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          x Pointer to a block array of pm->n blocks to store a mod m.
+ *          a Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           0 <= x < m even if a is negative.
+ */
+static bool _pbmMontLoad(const PBMMONT * pm, _ub * x, P_BINT a)
+{
+	register size_t i, n = pm->n, la = GETABS(GETFLAG(a));
+
+	if (la < n)
+	{
+		memcpy(x, a->data, la * sizeof(_ub));
+		memset(x + la, 0, (n - la) * sizeof(_ub));
+	}
+	else if (!pbbDivide(NULL, x, a->data, la, pm->m, n))
+		return false;
+
+	if (GETFLAG(a) < 0)
+	{
+		for (i = 0; i < n && 0 == x[i]; ++i)
+			;
+		if (i < n)
+			pbbSubtract(x, pm->m, n, x, n);
+	}
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmStoreBlocks
+ * Description:   Store a block array into a big integer.
+ * Parameters:
+ *          r Pointer to a big integer.
+ *          x Pointer to a block array.
+ *          n Number of blocks of x.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbmStoreBlocks(P_BINT r, const _ub * x, size_t n)
+{
+	if (!pbkReallocBint(r, (_ub)n, true))
+		return false;
+	memcpy(r->data, x, n * sizeof(_ub));
+	SETFLAG(r, (_ib)n);
+	pbkShrinkZeroFlag(r);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmMontMultiply
+ * Description:   Montgomery multiplication of two block arrays.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          c Pointer to a block array of pm->n blocks to store the result.
+ *          a Pointer to a block array of pm->n blocks. a < m.
+ *          b Pointer to a block array of pm->n blocks. b < m.
+ *          t Pointer to 2 * pm->n + 2 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           c := a * b / R mod m; c may equal to a or b.
+ *                Squares are computed by pbbSquare and then reduced. Other products are
+ *                interleaved with the reduction below gTuneTable.mulkara blocks, from
+ *                there they are computed by pbbMultiply and then reduced.
+ */
+static bool _pbmMontMultiply(const PBMMONT * pm, _ub * c, const _ub * a, const _ub * b, _ub * t)
+{
+	if (a == b)
+	{
+		if (!pbbSquare(t, a, pm->n))
+			return false;
+	}
+	else if (pm->n < gTuneTable.mulkara)
+	{
+		pbbMontgomeryMultiply(c, a, b, pm->m, pm->n, pm->k, t);
+		return true;
+	}
+	else if (!pbbMultiply(t, a, pm->n, b, pm->n))
+		return false;
+	pbbMontgomeryReduce(c, t, pm->m, pm->n, pm->k);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmMontExponential
+ * Description:   Calculates exp mod by a Montgomery context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          e Pointer to the exponent of le blocks.
+ *         le Number of blocks of e.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a ^ e mod m; r may equal to a.
+ *                a is converted into Montgomery form, raised by _pbmWindowPower and
+ *                converted back. Neither a nor e is changed.
+ */
+static bool _pbmMontExponential(const PBMMONT * pm, P_BINT r, P_BINT a, const _ub * e, size_t le)
+{
+	register size_t n = pm->n;
+	_ub * x, * y, * t;
+	bool bok = false;
+
+	while (le > 0 && 0 == e[le - 1])
+		--le;
+
+	if (NULL == (x = (_ub *)malloc((4 * n + 2) * sizeof(_ub))))
+		return false;
+	y = x + n;
+	t = y + n;
+
+	if (0 == le)
+	{
+		memset(x, 0, n * sizeof(_ub));
+		x[0] = 1;
+		bok = _pbmStoreBlocks(r, x, n);
+		goto Lbl_Finish;
+	}
+
+	/* y := a * R mod m. */
+	if (!_pbmMontLoad(pm, y, a) || !_pbmMontMultiply(pm, y, y, pm->rr, t))
+		goto Lbl_Finish;
+	if (!_pbmWindowPower(pm, NULL, x, y, e, le))
+		goto Lbl_Finish;
+
+	/* x := x / R mod m. */
+	memcpy(t, x, n * sizeof(_ub));
+	memset(t + n, 0, n * sizeof(_ub));
+	pbbMontgomeryReduce(x, t, pm->m, n, pm->k);
+	bok = _pbmStoreBlocks(r, x, n);
+Lbl_Finish:
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmInitMontgomery
+ * Description:   Initialize a Montgomery context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          m Pointer to a big integer that is the modulus.
+ * Return value:  true:  Succeeded.
+ *                false: Failed or m is not an odd number greater than 1.
+ * Tip:           -m ^ -1 mod B and R ^ 2 mod m are computed once here, so that one
+ *                context serves any number of multiplications by the same m.
+ *                Free the context by pbmFreeMontgomery.
+ */
+bool pbmInitMontgomery(P_PBMMONT pm, P_BINT m)
+{
+	register size_t n;
+	_ub * a;
+	bool bok;
+
+	if (pbkIsNotANumber(m) || !_PBM_IS_MONT(m))
+		return false;
+
+	for (n = GETFLAG(m); n > 1 && 0 == m->data[n - 1]; --n)
+		;
+	if (NULL == (pm->m = (_ub *)malloc(2 * n * sizeof(_ub))))
+		return false;
+	if (NULL == (a = (_ub *)calloc(2 * n + 1, sizeof(_ub))))
+	{
+		free(pm->m);
+		pm->m = NULL;
+		return false;
+	}
+	pm->rr = pm->m + n;
+	pm->n = n;
+	pm->k = pbbMontgomeryInvert1(m->data[0]);
+	memcpy(pm->m, m->data, n * sizeof(_ub));
+
+	/* R ^ 2 = B ^ (2 * n). */
+	a[2 * n] = 1;
+	bok = pbbDivide(NULL, pm->rr, a, 2 * n + 1, pm->m, n);
+	free(a);
+	if (!bok)
+	{
+		free(pm->m);
+		pm->m = NULL;
+	}
+	return bok;
+}
+
+/* Function name: pbmFreeMontgomery
+ * Description:   Free a Montgomery context.
+ * Parameter:
+ *         pm Pointer to a Montgomery context.
+ * Return value:  N/A.
+ */
+void pbmFreeMontgomery(P_PBMMONT pm)
+{
+	if (NULL != pm->m)
+		free(pm->m);
+	pm->m = pm->rr = NULL;
+	pm->n = 0;
+}
+
+/* Function name: pbmToMontgomery
+ * Description:   Convert a big integer into Montgomery form.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a * R mod m; r may equal to a.
+ */
+bool pbmToMontgomery(P_PBMMONT pm, P_BINT r, P_BINT a)
+{
+	register size_t n = pm->n;
+	_ub * x;
+	bool bok = false;
+
+	if (pbkIsNotANumber(a))
+		return false;
+	if (NULL == (x = (_ub *)malloc((3 * n + 2) * sizeof(_ub))))
+		return false;
+	if (_pbmMontLoad(pm, x, a) && _pbmMontMultiply(pm, x, x, pm->rr, x + n))
+		bok = _pbmStoreBlocks(r, x, n);
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmFromMontgomery
+ * Description:   Convert a big integer from Montgomery form.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer in Montgomery form.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a / R mod m; r may equal to a.
+ */
+bool pbmFromMontgomery(P_PBMMONT pm, P_BINT r, P_BINT a)
+{
+	register size_t n = pm->n;
+	_ub * t;
+	bool bok = false;
+
+	if (pbkIsNotANumber(a))
+		return false;
+	if (NULL == (t = (_ub *)malloc(2 * n * sizeof(_ub))))
+		return false;
+	if (_pbmMontLoad(pm, t, a))
+	{
+		memset(t + n, 0, n * sizeof(_ub));
+		pbbMontgomeryReduce(t, t, pm->m, n, pm->k);
+		bok = _pbmStoreBlocks(r, t, n);
+	}
+	free(t);
+	return bok;
+}
+
+/* Function name: pbmMontgomeryMultiply
+ * Description:   Multiplies two big integers in Montgomery form.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer in Montgomery form.
+ *          b Pointer to a big integer in Montgomery form.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a * b / R mod m; r may equal to a or b.
+ *                The product stays in Montgomery form. Pass a twice to square.
+ */
+bool pbmMontgomeryMultiply(P_PBMMONT pm, P_BINT r, P_BINT a, P_BINT b)
+{
+	register size_t n = pm->n;
+	_ub * x, * y;
+	bool bok = false;
+
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	if (NULL == (x = (_ub *)malloc((4 * n + 2) * sizeof(_ub))))
+		return false;
+	y = a == b ? x : x + n;
+	if (_pbmMontLoad(pm, x, a) && (a == b || _pbmMontLoad(pm, y, b)) &&
+		_pbmMontMultiply(pm, x, x, y, x + 2 * n))
+		bok = _pbmStoreBlocks(r, x, n);
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmMontgomeryExponential
+ * Description:   Calculates exp mod by a Montgomery context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       n shall not be negative.
+ * Tip:           r := a ^ n mod m; r may equal to a. a and r are not in Montgomery form.
+ *                Neither a nor n is changed.
+ */
+bool pbmMontgomeryExponential(P_PBMMONT pm, P_BINT r, P_BINT a, P_BINT n)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(n))
+		return false;
+	return _pbmMontExponential(pm, r, a, n->data, GETABS(GETFLAG(n)));
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmBarrettReduce
+ * Description:   Reduce a block array by Barrett's method.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          r Pointer to a block array of pb->n blocks to store the result.
+ *          t Pointer to a block array of 2 * pb->n blocks. It is destroyed.
+ *          w Pointer to 2 * pb->n + 3 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := t mod m; r may equal to t.
+ *                The quotient floor(t / m) is estimated from the high halves of t and
+ *                the reciprocal. One guard block keeps the error of the short product
+ *                pbbMulHigh under the lowest block, so the estimate is at most one
+ *                less and no more than two subtractions correct the remainder.
+ */
+static bool _pbmBarrettReduce(const PBMBARRETT * pb, _ub * r, _ub * t, _ub * w)
+{
+	register size_t n = pb->n;
+	_ub * q = w, * p = w + n + 2;
+
+	if (1 == n)
+	{
+		r[0] = pbbDivide1Inv(NULL, t, 2, &pb->i1);
+		return true;
+	}
+
+	/* q := floor(t / B ^ (n - 2)) * x / B ^ (n + 2). */
+	if (!pbbMulHigh(q, t + n - 2, pb->x, n + 2))
+		return false;
+
+	/* t := t - floor(q / B) * m mod B ^ (n + 1). The difference is less than 2 * m. */
+	if (!pbbMulLow(p, q + 1, pb->m, n + 1))
+		return false;
+	pbbSubtract(t, t, n + 1, p, n + 1);
+	while (t[n] || pbbCompare(t, pb->m, n) >= 0)
+		pbbSubtract(t, t, n + 1, pb->m, n + 1);
+
+	memmove(r, t, n * sizeof(_ub));
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmBarrettLoad
+ * Description:   Reduce a big integer by the modulus of a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          x Pointer to a block array of pb->n blocks to store a mod m.
+ *          a Pointer to a big integer.
+ *          t Pointer to 2 * pb->n scratch blocks.
+ *          w Pointer to 2 * pb->n + 3 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           0 <= x < |m| even if a is negative.
+ *                Blocks of a are folded in from the top, pb->n blocks at a time.
+ */
+static bool _pbmBarrettLoad(const PBMBARRETT * pb, _ub * x, P_BINT a, _ub * t, _ub * w)
+{
+	register size_t i, j, k, n = pb->n;
+
+	if (1 == n)
+		x[0] = pbbDivide1Inv(NULL, a->data, GETABS(GETFLAG(a)), &pb->i1);
+	else
+	{
+		memset(x, 0, n * sizeof(_ub));
+		for (j = GETABS(GETFLAG(a)); j > 0; j -= k)
+		{
+			/* t := x * B ^ k + k blocks of a below j. t < m * B ^ k. */
+			k = (j - 1) % n + 1;
+			memcpy(t, a->data + j - k, k * sizeof(_ub));
+			memcpy(t + k, x, n * sizeof(_ub));
+			memset(t + k + n, 0, (n - k) * sizeof(_ub));
+			if (!_pbmBarrettReduce(pb, x, t, w))
+				return false;
+		}
+	}
+
+	if (GETFLAG(a) < 0)
+	{
+		for (i = 0; i < n && 0 == x[i]; ++i)
+			;
+		if (i < n)
+			pbbSubtract(x, pb->m, n, x, n);
+	}
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmBarrettMultiply
+ * Description:   Multiplies two block arrays modulo the modulus of a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          c Pointer to a block array of pb->n blocks to store the result.
+ *          a Pointer to a block array of pb->n blocks. a < |m|.
+ *          b Pointer to a block array of pb->n blocks. b < |m|.
+ *          t Pointer to 4 * pb->n + 3 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           c := a * b mod m; c may equal to a or b.
+ */
+static bool _pbmBarrettMultiply(const PBMBARRETT * pb, _ub * c, const _ub * a, const _ub * b, _ub * t)
+{
+	if (a == b ? !pbbSquare(t, a, pb->n) : !pbbMultiply(t, a, pb->n, b, pb->n))
+		return false;
+	return _pbmBarrettReduce(pb, c, t, t + 2 * pb->n);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmBarrettExponential
+ * Description:   Calculates exp mod by a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          e Pointer to the exponent of le blocks.
+ *         le Number of blocks of e.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a ^ e mod m; r may equal to a.
+ *                a mod m is raised by _pbmWindowPower. Neither a nor e is changed.
+ */
+static bool _pbmBarrettExponential(const PBMBARRETT * pb, P_BINT r, P_BINT a, const _ub * e, size_t le)
+{
+	register size_t n = pb->n;
+	_ub * x, * y, * t;
+	bool bok = false;
+
+	while (le > 0 && 0 == e[le - 1])
+		--le;
+
+	if (NULL == (x = (_ub *)malloc((6 * n + 3) * sizeof(_ub))))
+		return false;
+	y = x + n;
+	t = y + n;
+
+	if (0 == le)
+	{
+		/* 1 mod m. */
+		memset(x, 0, n * sizeof(_ub));
+		x[0] = 1 == n && 1 == pb->m[0] ? 0 : 1;
+		bok = _pbmStoreBlocks(r, x, n);
+	}
+	else if (_pbmBarrettLoad(pb, y, a, t, t + 2 * n) && _pbmWindowPower(NULL, pb, x, y, e, le))
+		bok = _pbmStoreBlocks(r, x, n);
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmInitBarrett
+ * Description:   Initialize a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          m Pointer to a big integer that is the modulus.
+ * Return value:  true:  Succeeded.
+ *                false: Failed or m is 0.
+ * Caution:       The sign of m is ignored.
+ * Tip:           The reciprocal of m is computed once here, so that one context
+ *                serves any number of reductions by the same m without division.
+ *                Unlike Montgomery's method, m may be even and operands stay in their
+ *                usual form. Free the context by pbmFreeBarrett.
+ */
+bool pbmInitBarrett(P_PBMBARRETT pb, P_BINT m)
+{
+	register size_t n;
+	_ub * a;
+	bool bok = true;
+
+	if (pbkIsNotANumber(m) || pbkIsBintEqualToZero(m))
+		return false;
+
+	for (n = GETABS(GETFLAG(m)); n > 1 && 0 == m->data[n - 1]; --n)
+		;
+	if (NULL == (pb->m = (_ub *)malloc((2 * n + 3) * sizeof(_ub))))
+		return false;
+	pb->x = pb->m + n + 1;
+	pb->n = n;
+	memcpy(pb->m, m->data, n * sizeof(_ub));
+	pb->m[n] = 0;
+
+	if (1 == n)
+		pbbInvert1(&pb->i1, pb->m[0]);
+	else if (NULL == (a = (_ub *)malloc((2 * n + 1) * sizeof(_ub))))
+		bok = false;
+	else
+	{
+		/* x := floor((B ^ (2 * n + 1) - 1) / m) < B ^ (n + 2). */
+		memset(a, 0xff, (2 * n + 1) * sizeof(_ub));
+		bok = pbbDivide(pb->x, NULL, a, 2 * n + 1, pb->m, n);
+		free(a);
+	}
+	if (!bok)
+	{
+		free(pb->m);
+		pb->m = NULL;
+	}
+	return bok;
+}
+
+/* Function name: pbmFreeBarrett
+ * Description:   Free a Barrett context.
+ * Parameter:
+ *         pb Pointer to a Barrett context.
+ * Return value:  N/A.
+ */
+void pbmFreeBarrett(P_PBMBARRETT pb)
+{
+	if (NULL != pb->m)
+		free(pb->m);
+	pb->m = pb->x = NULL;
+	pb->n = 0;
+}
+
+/* Function name: pbmBarrettReduce
+ * Description:   Reduce a big integer by a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a mod m; 0 <= r < |m|; r may equal to a.
+ *                It costs about two multiplications of n blocks for each n blocks
+ *                of a, where n is the size of m.
+ */
+bool pbmBarrettReduce(P_PBMBARRETT pb, P_BINT r, P_BINT a)
+{
+	register size_t n = pb->n;
+	_ub * x;
+	bool bok = false;
+
+	if (pbkIsNotANumber(a))
+		return false;
+	if (NULL == (x = (_ub *)malloc((5 * n + 3) * sizeof(_ub))))
+		return false;
+	if (_pbmBarrettLoad(pb, x, a, x + n, x + 3 * n))
+		bok = _pbmStoreBlocks(r, x, n);
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmBarrettMultiply
+ * Description:   Multiplies two big integers modulo the modulus of a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           r := a * b mod m; 0 <= r < |m|; r may equal to a or b.
+ *                Pass a twice to square.
+ */
+bool pbmBarrettMultiply(P_PBMBARRETT pb, P_BINT r, P_BINT a, P_BINT b)
+{
+	register size_t n = pb->n;
+	_ub * x, * y, * t, * w;
+	bool bok = false;
+
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b))
+		return false;
+	if (NULL == (x = (_ub *)malloc((6 * n + 3) * sizeof(_ub))))
+		return false;
+	y = a == b ? x : x + n;
+	t = x + 2 * n;
+	w = t + 2 * n;
+	if (_pbmBarrettLoad(pb, x, a, t, w) && (a == b || _pbmBarrettLoad(pb, y, b, t, w)) &&
+		_pbmBarrettMultiply(pb, x, x, y, t))
+		bok = _pbmStoreBlocks(r, x, n);
+	free(x);
+	return bok;
+}
+
+/* Function name: pbmBarrettExponential
+ * Description:   Calculates exp mod by a Barrett context.
+ * Parameters:
+ *         pb Pointer to a Barrett context.
+ *          r Pointer to a big integer that is the result.
+ *          a Pointer to a big integer.
+ *          n Power of n.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The sign of n is ignored.
+ * Tip:           r := a ^ n mod m; 0 <= r < |m|; r may equal to a.
+ *                Neither a nor n is changed.
+ */
+bool pbmBarrettExponential(P_PBMBARRETT pb, P_BINT r, P_BINT a, P_BINT n)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(n))
+		return false;
+	return _pbmBarrettExponential(pb, r, a, n->data, GETABS(GETFLAG(n)));
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmLoadMod
+ * Description:   Convert a big integer into the form of a Montgomery or Barrett context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context or NULL.
+ *         pb Pointer to a Barrett context if pm is NULL.
+ *          x Pointer to a block array of n blocks to store the result.
+ *          a Pointer to a big integer.
+ *          t Pointer to 4 * n + 3 scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           x := a * R mod m for Montgomery contexts, x := a mod m for Barrett ones.
+ */
+static bool _pbmLoadMod(const PBMMONT * pm, const PBMBARRETT * pb, _ub * x, P_BINT a, _ub * t)
+{
+	if (NULL != pm)
+		return _pbmMontLoad(pm, x, a) && _pbmMontMultiply(pm, x, x, pm->rr, t);
+	return _pbmBarrettLoad(pb, x, a, t, t + 2 * pb->n);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmStoreMod
+ * Description:   Convert a block array from the form of a Montgomery or Barrett context.
+ * Parameters:
+ *         pm Pointer to a Montgomery context or NULL.
+ *         pb Pointer to a Barrett context if pm is NULL.
+ *          r Pointer to a big integer that is the result.
+ *          x Pointer to a block array of n blocks. It is destroyed.
+ *          t Pointer to 2 * n scratch blocks.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbmStoreMod(const PBMMONT * pm, const PBMBARRETT * pb, P_BINT r, _ub * x, _ub * t)
+{
+	if (NULL != pm)
+	{
+		memcpy(t, x, pm->n * sizeof(_ub));
+		memset(t + pm->n, 0, pm->n * sizeof(_ub));
+		pbbMontgomeryReduce(x, t, pm->m, pm->n, pm->k);
+		return _pbmStoreBlocks(r, x, pm->n);
+	}
+	return _pbmStoreBlocks(r, x, pb->n);
+}
+
+/* Function name: pbmInitComb
+ * Description:   Initialize a fixed-base exponentiation context.
+ * Parameters:
+ *         pc Pointer to a comb context.
+ *          g Pointer to a big integer that is the base.
+ *          m Pointer to a big integer that is the modulus.
+ *       bits Maximum bits of exponents.
+ * Return value:  true:  Succeeded.
+ *                false: Failed or m is 0.
+ * Caution:       The sign of m is ignored.
+ * Tip:           Exponents of bits bits are cut into h rows of a = ceil(bits / h) bits,
+ *                and each row into v pieces of b = ceil(a / v) bits. Table k holds the
+ *                2 ^ h products of g ^ (2 ^ (j * a + k * b)) for rows j. h and v are
+ *                PBM_COMB_TEETH and PBM_COMB_TABLES unless bits is too short.
+ *                Building the tables costs about bits squarings and v * 2 ^ h
+ *                multiplications, once. Free the context by pbmFreeComb.
+ */
+bool pbmInitComb(P_PBMCOMB pc, P_BINT g, P_BINT m, size_t bits)
+{
+	register size_t i, j, k, s, n, a, b, p = 0;
+	const PBMMONT * pm = NULL;
+	const PBMBARRETT * pb = NULL;
+	_ub * y, * t;
+	bool bok = false;
+
+	memset(pc, 0, sizeof(PBMCOMB));
+	if (pbkIsNotANumber(g) || pbkIsNotANumber(m))
+		return false;
+	if (_PBM_IS_MONT(m))
+	{
+		if (!pbmInitMontgomery(&pc->mt, m))
+			return false;
+		pm = &pc->mt;
+		n = pm->n;
+	}
+	else
+	{
+		if (!pbmInitBarrett(&pc->br, m))
+			return false;
+		pb = &pc->br;
+		n = pb->n;
+	}
+
+	pc->bits = GETMAX(bits, 1);
+	pc->h = GETMIN(PBM_COMB_TEETH, pc->bits);
+	a = (pc->bits + pc->h - 1) / pc->h;
+	b = GETMIN(PBM_COMB_TABLES, a);
+	b = (a + b - 1) / b;
+	pc->v = (a + b - 1) / b;
+
+	if (NULL == (pc->tbl = (_ub *)malloc((pc->v * ((size_t)1 << pc->h) * n + 5 * n + 3) * sizeof(_ub))))
+		goto Lbl_Finish;
+	y = pc->tbl + pc->v * ((size_t)1 << pc->h) * n;
+	t = y + n;
+
+	/* Table k, entry 2 ^ j := g ^ (2 ^ (j * a + k * b)). Positions increase with j, then k. */
+	if (!_pbmLoadMod(pm, pb, y, g, t))
+		goto Lbl_Finish;
+	for (j = 0; j < pc->h; ++j)
+	{
+		for (k = 0; k < pc->v; ++k)
+		{
+			for (; p < j * a + k * b; ++p)
+				if (!_pbmMulMod(pm, pb, y, y, y, t))
+					goto Lbl_Finish;
+			memcpy(pc->tbl + ((k << pc->h) + ((size_t)1 << j)) * n, y, n * sizeof(_ub));
+		}
+	}
+
+	/* Entry s := entry (s without its lowest bit) * entry (lowest bit of s). */
+	for (k = 0; k < pc->v; ++k)
+	{
+		_ub * tk = pc->tbl + (k << pc->h) * n;
+		for (s = 3; s < ((size_t)1 << pc->h); ++s)
+		{
+			i = s & (s - 1);
+			if (0 != i && !_pbmMulMod(pm, pb, tk + s * n, tk + i * n, tk + (s ^ i) * n, t))
+				goto Lbl_Finish;
+		}
+	}
+	bok = true;
+Lbl_Finish:
+	if (!bok)
+		pbmFreeComb(pc);
+	return bok;
+}
+
+/* Function name: pbmFreeComb
+ * Description:   Free a fixed-base exponentiation context.
+ * Parameter:
+ *         pc Pointer to a comb context.
+ * Return value:  N/A.
+ */
+void pbmFreeComb(P_PBMCOMB pc)
+{
+	if (NULL != pc->tbl)
+		free(pc->tbl);
+	pc->tbl = NULL;
+	if (NULL != pc->mt.m)
+		pbmFreeMontgomery(&pc->mt);
+	if (NULL != pc->br.m)
+		pbmFreeBarrett(&pc->br);
+}
+
+/* Function name: pbmCombExponential
+ * Description:   Calculates exp mod by a fixed-base exponentiation context.
+ * Parameters:
+ *         pc Pointer to a comb context.
+ *          r Pointer to a big integer that is the result.
+ *          n Power of n.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The sign of n is ignored.
+ * Tip:           r := g ^ n mod m; 0 <= r < |m|. n is not changed.
+ *                Bit i of piece k of every row makes an index into table k. Each of the
+ *                b rounds squares once and multiplies once by every table, so it costs
+ *                about bits / (h * v) squarings and bits / h multiplications.
+ *                Exponents longer than pc->bits bits use sliding window exponentiation.
+ */
+bool pbmCombExponential(P_PBMCOMB pc, P_BINT r, P_BINT n)
+{
+	register size_t i, j, k, p, x, a, b, le, l;
+	const PBMMONT * pm = NULL != pc->mt.m ? &pc->mt : NULL;
+	const PBMBARRETT * pb = NULL != pm ? NULL : &pc->br;
+	const _ub * e = n->data;
+	_ub * y, * t;
+	bool bok = false, bfirst = true;
+
+	if (pbkIsNotANumber(n))
+		return false;
+	l = NULL != pm ? pm->n : pb->n;
+	for (le = GETABS(GETFLAG(n)); le > 0 && 0 == e[le - 1]; --le)
+		;
+
+	if (NULL == (y = (_ub *)malloc((5 * l + 3) * sizeof(_ub))))
+		return false;
+	t = y + l;
+
+	a = (pc->bits + pc->h - 1) / pc->h;
+	b = (a + pc->v - 1) / pc->v;
+
+	/* Index of the highest bit of n plus 1. */
+	for (p = le * UB_BIT; p > 0 && !_PBM_BIT(e, p - 1); --p)
+		;
+	if (p > pc->bits)
+	{
+		/* Longer than the tables. */
+		if (!_pbmWindowPower(pm, pb, y, pc->tbl + l, e, le))
+			goto Lbl_Finish;
+		bfirst = false;
+	}
+	else
+	{
+		for (i = b; i-- > 0; )
+		{
+			if (!bfirst && !_pbmMulMod(pm, pb, y, y, y, t))
+				goto Lbl_Finish;
+			for (k = 0; k < pc->v && k * b + i < a; ++k)
+			{
+				for (x = 0, j = pc->h; j-- > 0; )
+				{
+					p = j * a + k * b + i;
+					x = (x << 1) | (p < le * UB_BIT ? _PBM_BIT(e, p) : 0);
+				}
+				if (0 == x)
+					continue;
+				if (bfirst)
+				{
+					memcpy(y, pc->tbl + ((k << pc->h) + x) * l, l * sizeof(_ub));
+					bfirst = false;
+				}
+				else if (!_pbmMulMod(pm, pb, y, y, pc->tbl + ((k << pc->h) + x) * l, t))
+					goto Lbl_Finish;
+			}
+		}
+	}
+
+	if (bfirst)
+	{
+		/* n = 0. */
+		memset(y, 0, l * sizeof(_ub));
+		y[0] = NULL == pm && 1 == pb->n && 1 == pb->m[0] ? 0 : 1;
+		bok = _pbmStoreBlocks(r, y, l);
+	}
+	else
+		bok = _pbmStoreMod(pm, pb, r, y, t);
+Lbl_Finish:
+	free(y);
+	return bok;
+}
+
+/* Function name: pbmUbFactorial
+ * Description:   Factorial of an integer.
+ * Parameters:
+ *          r Pointer to a big integer to store the result.
+ *          n fact(n).
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Big value of n is slow to solve.
+ */
+bool pbmUbFactorial(P_BINT r, _ub n)
+{
+	BINT R = { 0 }, N = { 0 };
+
+	pbkInitBint(&R, 0);
+	pbkInitBint(&N, 0);
+
+	SETFLAG(r, 1);
+	r->data[0] = 1;
+
+	SETFLAG(&N, 1);
+
+	while (n - 1)
+	{
+		if (!pbkMoveBint(&R, r))
+		{
+			pbkFreeBint(&R);
+			pbkFreeBint(&N);
+			return false;
+		}
+		N.data[0] = n;
+		if (!pbkMultiplyBint(r, &N, &R))
+		{
+			pbkFreeBint(&R);
+			pbkFreeBint(&N);
+			return false;
+		}
+		--n;
+	}
+
+	pbkFreeBint(&R);
+	pbkFreeBint(&N);
+	return true;
+}
+
+/* Function name: pbmBintSquareRoot
+ * Description:   Gets the square root of a big integer.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *          n sqrt(n).
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+bool pbmBintSquareRoot(P_BINT r, P_BINT n)
+{
+	BINT * xk = r, XK1 = { 0 }, X = { 0 };
+	if (pbkIsNotANumber(n))
+		return false;
+	else
+	{
+		pbkInitBint(&X, 0);
+		pbkMoveBint(&XK1, n);
+
+		do
+		{
+			if (!pbkMoveBint(xk, &XK1))
+				goto Lbl_Failure;
+			if (!pbkDivBint(&X, n, xk))
+				goto Lbl_Failure;
+			if (!pbkAddBint(&XK1, &X, xk))
+				goto Lbl_Failure;
+			if (!pbkRightShiftBint(&XK1, 0, 1))
+				goto Lbl_Failure;
+		}
+		while (pbkCompareBint(&XK1, xk) < 0);
+		pbkFreeBint(&XK1);
+		pbkFreeBint(&X);
+		return true;
+	}
+Lbl_Failure:
+	pbkFreeBint(&XK1);
+	pbkFreeBint(&X);
+	return false;
+}
+
+/* Function name: pbmBintKthRoot
+ * Description:   Gets the kth root of the big integer m.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *          m Pointer to a big integer.
+ *          k m^(1/k).
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       k must >= 2.
+ */
+bool pbmBintKthRoot(P_BINT r, P_BINT m, _ub k)
+{
+	BINT U = { 0 }, X = { 0 }, Y = { 0 }, Z = { 0 };
+	
+	if (k < 2)
+		return false;
+	
+	if (pbkIsNotANumber(m) || pbkIsNotANumber(r))
+		return false;
+	else
+	{
+		pbkInitBint(&X, 0);
+		pbkInitBint(&Y, 0);
+		pbkInitBint(&Z, 0);
+		
+		pbkInitBint(&U, 0);
+		pbkMoveBint(&U, m);
+		
+		do
+		{	
+			pbkMoveBint(r, &U);
+			
+			pbmBintPower(&X, r, k - 1);
+			
+			pbkDivBint(&Y, m, &X);
+			
+			Z.data[0] = k - 1;
+			SETFLAG(&Z, 1);
+			
+			pbkMultiplyBint(&X, r, &Z);
+			
+			pbkAddBint(&Z, &X, &Y);
+			
+			pbkIbToBint(&X, (_ib)k);
+			
+			pbkDivBint(&U, &Z, &X);
+		}
+		while (pbkCompareBint(&U, r) < 0);
+		
+		pbkFreeBint(&U);
+		pbkFreeBint(&X);
+		pbkFreeBint(&Y);
+		pbkFreeBint(&Z);
+		
+		return true;
+	}
+	return false;
+}
+
+/* Function name: pbmBintKthRootBint
+ * Description:   Gets the big integer kth root of the big integer m.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *          m Pointer to a big integer.
+ *          k m^(1/k).
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       k must >= 2.
+ */
+bool pbmBintKthRootBint(P_BINT r, P_BINT m, P_BINT k)
+{
+	BINT U = { 0 }, X = { 0 }, Y = { 0 }, Z = { 0 }, T = { 0 }, I = { 0 };
+	if (pbkIsNotANumber(r) || pbkIsNotANumber(m) || pbkIsNotANumber(k))
+		return false;
+	else
+	{
+		pbkInitBint(&X, 2);
+		
+		if (pbkCompareBint(k, &X) < 0)
+		{
+			pbkFreeBint(&X);
+			return false;
+		}
+		
+		pbkInitBint(&Y, 0);
+		pbkInitBint(&Z, 0);
+		pbkInitBint(&T, 0);
+		pbkInitBint(&I, 1);
+		
+		pbkInitBint(&U, 0);
+		pbkMoveBint(&U, m);
+		
+		do
+		{	
+			pbkMoveBint(r, &U);
+			
+			pbkSubtractBint(&T, k, &I);
+			
+			pbmBintPowerBint(&X, r, &T);
+			
+			pbkDivBint(&Y, m, &X);
+			
+			pbkSubtractBint(&T, k, &I);
+			
+			pbkMultiplyBint(&X, r, &T);
+			
+			pbkAddBint(&Z, &X, &Y);
+			
+			pbkDivBint(&U, &Z, k);
+		}
+		while (pbkCompareBint(&U, r) < 0);
+		
+		pbkFreeBint(&U);
+		pbkFreeBint(&X);
+		pbkFreeBint(&Y);
+		pbkFreeBint(&Z);
+		pbkFreeBint(&T);
+		pbkFreeBint(&I);
+		
+		return true;
+	}
+	return false;
+}
+
+/* Function name: pbmBintGreatestCommonDivisor
+ * Description:   Gets the greatest common divisor of two big integers.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       After invoking, the value of a and b are both CHANGED!
+ * Tip:           This function uses Euclidian algorithm.
+ */
+bool pbmBintGreatestCommonDivisor(P_BINT r, P_BINT a, P_BINT b)
+{
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsNotANumber(r))
+		return false;
+	else
+	{
+		while (!pbkIsBintEqualToZero(b))
+		{
+			if (!pbkModBint(r, a, b))
+				goto Lbl_Failed;
+
+			if (!pbkMoveBint(a, b))
+				goto Lbl_Failed;
+
+			if (!pbkMoveBint(b, r))
+				goto Lbl_Failed;
+		}
+		if (!pbkMoveBint(r, a))
+			goto Lbl_Failed;
+
+		return true;
+	}
+Lbl_Failed:
+	return false;
+}
+
+/* Function name: pbmBintLeastCommonMultiple
+ * Description:   Gets the least common multiple of two big integers.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *          a Pointer to a big integer.
+ *          b Pointer to a big integer.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           a * b is divided by the greatest common divisor exactly,
+ *                see pbkDivideExactBint.
+ */
+bool pbmBintLeastCommonMultiple(P_BINT r, P_BINT a, P_BINT b)
+{
+	BINT T = {0}, U = {0};
+	
+	if (pbkIsNotANumber(a) || pbkIsNotANumber(b) || pbkIsNotANumber(r))
+		return false;
+	else
+	{
+		pbkInitBint(&T, 0);
+		pbkInitBint(&U, 0);
+		
+		if (!pbkMultiplyBint(&U, a, b))
+			goto Lbl_Failed;
+		
+		if (!pbmBintGreatestCommonDivisor(&T, a, b))
+			goto Lbl_Failed;
+		
+		if (!pbkIsBintEqualToZero(&T))
+		{
+			if (!pbkDivideExactBint(r, &U, &T))
+				goto Lbl_Failed;
+		}
+		else
+			goto Lbl_Failed;
+		
+		pbkFreeBint(&T);
+		pbkFreeBint(&U);
+		return true;
+	}
+Lbl_Failed:
+	pbkFreeBint(&T);
+	pbkFreeBint(&U);
+	return false;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbmRand1Block
+ * Description:   Generate 1 block random number.
+ * Parameters:    N/A.
+ * Return value:  Random number.
+ */
+_ub _pbmRand1Block(void)
+{
+	register _udb u = 1;
+	register _ub v = 1;
+	register size_t i, j = 0;
+	while (!(u >> UB_BIT))
+	{
+		u *= RAND_MAX;
+		++j;
+	}
+	for (i = 0; i < j; ++i)
+		v *= rand();
+	return v;
+}
+
+/* Function name: pbmRandomGenerator
+ * Description:   An RNG.
+ * Parameters:
+ *          r Pointer to a big integer to store result.
+ *     blocks Maximum number of blocks to be generate.
+ *     blarge false Generate a smaller integer than blocks.
+ *            true  Generate a larger integer than blocks - 1.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+bool pbmRandomGenerator(P_BINT r, _ub blocks, bool blarge)
+{
+	size_t i = RAND_1_TIME(1, blocks), j;
+	if (!pbkReallocBint(r, (_ub)i, false))
+		return false;
+	r->data[0] = 0;
+	for (j = 0; j < (blarge ? i : i - 1); ++j)
+		r->data[j] = _pbmRand1Block();
+	SETFLAG(r, (_ib)GETMAX(j, 1));
+	pbkShrinkZeroFlag(r);
+	return true;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbkIsPrimePrimary
+ * Description:   Test prime number.
+ * Parameter:
+ *         n Pointer to a big integer to be tested.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           Trial division by the primes in gPrimeTable1K. Primes are multiplied
+ *                into single blocks so that pbbModulo1Multi reads n only once.
+ */
+bool _pbkIsPrimePrimary(P_BINT n)
+{
+	size_t i, j, k = 0;
+	size_t g[PTSIZ];
+	_ub rm[PTSIZ];
+	_udb t;
+	PBBINV1 inv[PTSIZ];
+
+	if (pbkIsNotANumber(n))
+		return false;
+
+	/* Multiply small primes into groups of one block. g[k] is the first prime of group k. */
+	for (i = 1; i < PTSIZ; ++k)
+	{
+		g[k] = i;
+		for (t = 1; i < PTSIZ && t * gPrimeTable1K[i] <= UBLOCK_FULL; ++i)
+			t *= gPrimeTable1K[i];
+		pbbInvert1(&inv[k], (_ub)t);
+	}
+	g[k] = PTSIZ;
+
+	/* One pass over n for all groups. */
+	pbbModulo1Multi(rm, n->data, GETABS(GETFLAG(n)), inv, k);
+	for (j = 0; j < k; ++j)
+		for (i = g[j]; i < g[j + 1]; ++i)
+			if (0 == rm[j] % gPrimeTable1K[i])
+				return false;
+	return true;
+}
+
+/* Function name: pbmMillerRabinTest
+ * Description:   Miller Rabin primality test.
+ * Parameters:
+ *          r Pointer to a big integer to be tested.
+ *          k K times of evaluation. K should be greater than 8.
+ * Return value:  true:  n is a pseudo prime.
+ *                false: n is NOT a prime.
+ * Tip:           One Montgomery context of n serves all k rounds.
+ */
+bool pbmMillerRabinTest(P_BINT n, _ub k)
+{
+	BINT A = { 0 }, X = { 0 }, N_1 = { 0 }, U = { 0 }, V = { 0 }, T = { 0 };
+	PBMMONT mt = { 0 };
+	bool r = true;
+	_udb t = 0, s;
+	size_t i;
+	if (GETFLAG(n) < 1 || (1 == GETFLAG(n) && n->data[0] < 3) || 0 == (n->data[0] & 1))
+	{
+		if (1 == GETFLAG(n) && 2 == n->data[0])
+			return true;
+		else
+			return false;
+	}
+	else
+	{
+		if (1 == GETFLAG(n) && n->data[0] <= gPrimeTable1K[PTSIZ - 1])
+		{
+			for (i = 1; i < PTSIZ && gPrimeTable1K[i] < n->data[0]; ++i)
+				;
+			return i < PTSIZ && gPrimeTable1K[i] == n->data[0];
+		}
+
+		if (false == _pbkIsPrimePrimary(n))
+			return false;
+
+		if (!pbmInitMontgomery(&mt, n))
+			return false;
+
+		pbkInitBint(&A, 0);
+		pbkInitBint(&X, 1);
+		pbkInitBint(&N_1, 0);
+		pbkInitBint(&V, 3);
+		pbkInitBint(&T, 2);
+
+		if (!pbkSubtractBint(&N_1, n, &X))
+		{
+			r = false;
+			goto Lbl_Finish;
+		}
+
+		if (!pbkMoveBint(&U, &N_1))
+		{
+			r = false;
+			goto Lbl_Finish;
+		}
+
+		while (0 == (U.data[0] & 1))
+		{
+			pbkRightShiftBint(&U, 0, 1);
+			++t;
+		}
+
+		/* Bases are taken from 2 to n - 2. */
+		if (!pbkSubtractBint(&X, n, &V))
+		{
+			r = false;
+			goto Lbl_Finish;
+		}
+
+		/* Squarings below compare with n - 1 in Montgomery form. */
+		if (!pbmToMontgomery(&mt, &N_1, &N_1))
+		{
+			r = false;
+			goto Lbl_Finish;
+		}
+
+		for (i = 0; i < k; ++i)
+		{
+			if (GETFLAG(n) > 1)
+			{
+				if (!pbmRandomGenerator(&A, GETABS(GETFLAG(n)) - 1, true))
+				{
+					r = false;
+					goto Lbl_Finish;
+				}
+			}
+			else
+			{
+				if (!pbmRandomGenerator(&A, 1, true))
+				{
+					r = false;
+					goto Lbl_Finish;
+				}
+			}
+
+			if (!pbkModBint(&V, &A, &X) || !pbkAddBint(&A, &V, &T))
+			{
+				r = false;
+				goto Lbl_Finish;
+			}
+
+			if (!pbmMontgomeryExponential(&mt, &V, &A, &U))
+			{
+				r = false;
+				goto Lbl_Finish;
+			}
+
+			if (1 == GETFLAG(&V) && 1 == V.data[0])
+				continue;
+
+			if (!pbmToMontgomery(&mt, &V, &V))
+			{
+				r = false;
+				goto Lbl_Finish;
+			}
+
+			for (s = 0; s < t; ++s)
+			{
+				if (0 == pbkCompareBint(&V, &N_1))
+					break;
+
+				if (!pbmMontgomeryMultiply(&mt, &V, &V, &V))
+				{
+					r = false;
+					goto Lbl_Finish;
+				}
+			}
+			if (s == t)
+			{
+				r = false;
+				goto Lbl_Finish;
+			}
+		}
+		r = true;
+	}
+Lbl_Finish:
+	pbkFreeBint(&A);
+	pbkFreeBint(&X);
+	pbkFreeBint(&N_1);
+	pbkFreeBint(&U);
+	pbkFreeBint(&V);
+	pbkFreeBint(&T);
+	pbmFreeMontgomery(&mt);
+	return r;
+}
+
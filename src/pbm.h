@@ -1,29 +1,84 @@
-/*
- * Name:        pbm.h
- * Description: Portable big integer library mathematics module.
- * Author:      cosh.cage#hotmail.com
- * File ID:     0520240323C0225262300L00029
- * License:     GPLv3.
- */
-
-#ifndef _PBM_H_
-#define _PBM_H_
-
-#include "pbk.h"
-
-/* Function declarations. */
-bool pbmBintPower                (P_BINT r, P_BINT a,      _ub      n);
-bool pbmBintPowerBint            (P_BINT r, P_BINT a,      P_BINT   n);
-bool pbmBintExponentialModule    (P_BINT r, P_BINT a,      _ub      n,     P_BINT m);
-bool pbmBintExponentialModuleBint(P_BINT r, P_BINT a,      P_BINT   n,     P_BINT m);
-bool pbmUbFactorial              (P_BINT r, _ub    n);
-bool pbmBintSquareRoot           (P_BINT r, P_BINT n);
-bool pbmBintKthRoot              (P_BINT r, P_BINT m,      _ub      k);
-bool pbmBintKthRootBint          (P_BINT r, P_BINT m,      P_BINT   k);
-bool pbmBintGreatestCommonDivisor(P_BINT r, P_BINT a,      P_BINT   b);
-bool pbmBintLeastCommonMultiple  (P_BINT r, P_BINT a,      P_BINT   b);
-bool pbmRandomGenerator          (P_BINT r, _ub    blocks, bool     blarge);
-bool pbmMillerRabinTest          (P_BINT n, _ub    k);
-
-#endif
-
+/*
+ * Name:        pbm.h
+ * Description: Portable big integer library mathematics module.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     0520240323C1019261615L00084
+ * License:     GPLv3.
+ */
+
+#ifndef _PBM_H_
+#define _PBM_H_
+
+#include "pbk.h"
+#include "pbb.h"
+
+/* Montgomery context of an odd modulus m > 1. R = B ^ n where B = 2 ^ UB_BIT. */
+typedef struct st_PBMMONT
+{
+	_ub *  m;  /* Modulus of n blocks. */
+	_ub *  rr; /* R ^ 2 mod m of n blocks. */
+	size_t n;  /* Blocks of the modulus. */
+	_ub    k;  /* -m ^ -1 mod B. */
+} PBMMONT, * P_PBMMONT;
+
+/* Barrett context of a modulus m != 0. */
+typedef struct st_PBMBARRETT
+{
+	_ub *   m;  /* |m| of n + 1 blocks. The highest block is 0. */
+	_ub *   x;  /* floor((B ^ (2 * n + 1) - 1) / |m|) of n + 2 blocks. */
+	size_t  n;  /* Blocks of the modulus. */
+	PBBINV1 i1; /* Reciprocal of |m| if n is 1. */
+} PBMBARRETT, * P_PBMBARRETT;
+
+/* Shape of fixed-base comb tables. */
+#ifndef PBM_COMB_TEETH
+#define PBM_COMB_TEETH  8U /* Rows of a comb. Each table holds 2 ^ PBM_COMB_TEETH powers. */
+#endif
+#ifndef PBM_COMB_TABLES
+#define PBM_COMB_TABLES 4U /* Tables of a comb. Each divides the squarings left. */
+#endif
+
+/* Fixed-base exponentiation context of g modulo m by Lim-Lee comb. */
+typedef struct st_PBMCOMB
+{
+	PBMMONT    mt;   /* Context of m if m is an odd number greater than 1. */
+	PBMBARRETT br;   /* Context of m otherwise. */
+	_ub *      tbl;  /* v tables of 2 ^ h products of powers of g in the form of the context. */
+	size_t     bits; /* Bits of exponents covered by the tables. */
+	size_t     h;    /* Rows of the comb. */
+	size_t     v;    /* Tables. */
+} PBMCOMB, * P_PBMCOMB;
+
+/* Function declarations. */
+bool pbmBintPower                (P_BINT r, P_BINT a,      _ub      n);
+bool pbmBintPowerBint            (P_BINT r, P_BINT a,      P_BINT   n);
+bool pbmBintExponentialModule    (P_BINT r, P_BINT a,      _ub      n,     P_BINT m);
+bool pbmBintExponentialModuleBint(P_BINT r, P_BINT a,      P_BINT   n,     P_BINT m);
+bool pbmUbFactorial              (P_BINT r, _ub    n);
+bool pbmBintSquareRoot           (P_BINT r, P_BINT n);
+bool pbmBintKthRoot              (P_BINT r, P_BINT m,      _ub      k);
+bool pbmBintKthRootBint          (P_BINT r, P_BINT m,      P_BINT   k);
+bool pbmBintGreatestCommonDivisor(P_BINT r, P_BINT a,      P_BINT   b);
+bool pbmBintLeastCommonMultiple  (P_BINT r, P_BINT a,      P_BINT   b);
+bool pbmRandomGenerator          (P_BINT r, _ub    blocks, bool     blarge);
+bool pbmMillerRabinTest          (P_BINT n, _ub    k);
+/* Functions for Montgomery contexts. */
+bool pbmInitMontgomery           (P_PBMMONT pm, P_BINT m);
+void pbmFreeMontgomery           (P_PBMMONT pm);
+bool pbmToMontgomery             (P_PBMMONT pm, P_BINT r, P_BINT a);
+bool pbmFromMontgomery           (P_PBMMONT pm, P_BINT r, P_BINT a);
+bool pbmMontgomeryMultiply       (P_PBMMONT pm, P_BINT r, P_BINT a, P_BINT b);
+bool pbmMontgomeryExponential    (P_PBMMONT pm, P_BINT r, P_BINT a, P_BINT n);
+/* Functions for Barrett contexts. */
+bool pbmInitBarrett              (P_PBMBARRETT pb, P_BINT m);
+void pbmFreeBarrett              (P_PBMBARRETT pb);
+bool pbmBarrettReduce            (P_PBMBARRETT pb, P_BINT r, P_BINT a);
+bool pbmBarrettMultiply          (P_PBMBARRETT pb, P_BINT r, P_BINT a, P_BINT b);
+bool pbmBarrettExponential       (P_PBMBARRETT pb, P_BINT r, P_BINT a, P_BINT n);
+/* Functions for fixed-base comb contexts. */
+bool pbmInitComb                 (P_PBMCOMB pc, P_BINT g, P_BINT m, size_t bits);
+void pbmFreeComb                 (P_PBMCOMB pc);
+bool pbmCombExponential          (P_PBMCOMB pc, P_BINT r, P_BINT n);
+
+#endif
+
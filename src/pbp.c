@@ -0,0 +1,535 @@
+/*
+ * Name:        pbp.c
+ * Description: Portable big integer library parallel support.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     1019261045B1019261700L00535
+ * License:     GPLv3.
+ */
+
+#include "pbp.h"
+#include <stdlib.h> /* Using function malloc, calloc, free. */
+
+#ifndef PBK_NO_THREADS
+
+#ifdef _WIN32
+#include <Windows.h>
+typedef CRITICAL_SECTION   PBPMUTEX;
+typedef CONDITION_VARIABLE PBPCOND;
+typedef HANDLE             PBPTHREAD;
+#define PBP_MUTEX_INIT(m)    (InitializeCriticalSection(m), true)
+#define PBP_MUTEX_FREE(m)    DeleteCriticalSection(m)
+#define PBP_LOCK(m)          EnterCriticalSection(m)
+#define PBP_TRYLOCK(m)       (0 != TryEnterCriticalSection(m))
+#define PBP_UNLOCK(m)        LeaveCriticalSection(m)
+#define PBP_COND_INIT(c)     (InitializeConditionVariable(c), true)
+#define PBP_COND_FREE(c)
+#define PBP_WAIT(c, m)       SleepConditionVariableCS((c), (m), INFINITE)
+#define PBP_SIGNAL(c)        WakeConditionVariable(c)
+#define PBP_BROADCAST(c)     WakeAllConditionVariable(c)
+#define PBP_YIELD()          SwitchToThread()
+#define PBP_CREATE(t, pw)    (NULL != (*(t) = CreateThread(NULL, 0, _pbpThread, (pw), 0, NULL)))
+#define PBP_WAITTHREAD(t)    (WaitForSingleObject((t), INFINITE), CloseHandle(t))
+#else
+#include <pthread.h>
+#include <sched.h>
+typedef pthread_mutex_t    PBPMUTEX;
+typedef pthread_cond_t     PBPCOND;
+typedef pthread_t          PBPTHREAD;
+#define PBP_MUTEX_INIT(m)    (0 == pthread_mutex_init((m), NULL))
+#define PBP_MUTEX_FREE(m)    pthread_mutex_destroy(m)
+#define PBP_LOCK(m)          pthread_mutex_lock(m)
+#define PBP_TRYLOCK(m)       (0 == pthread_mutex_trylock(m))
+#define PBP_UNLOCK(m)        pthread_mutex_unlock(m)
+#define PBP_COND_INIT(c)     (0 == pthread_cond_init((c), NULL))
+#define PBP_COND_FREE(c)     pthread_cond_destroy(c)
+#define PBP_WAIT(c, m)       pthread_cond_wait((c), (m))
+#define PBP_SIGNAL(c)        pthread_cond_signal(c)
+#define PBP_BROADCAST(c)     pthread_cond_broadcast(c)
+#define PBP_YIELD()          sched_yield()
+#define PBP_CREATE(t, pw)    (0 == pthread_create((t), NULL, _pbpThread, (pw)))
+#define PBP_WAITTHREAD(t)    pthread_join((t), NULL)
+#endif
+
+#define PBP_ALIGN(s) (((s) + sizeof(double) - 1) & ~(sizeof(double) - 1))
+
+/* A chunk of scratch memory. Data follows the header. */
+typedef struct st_PBPCHUNK
+{
+	struct st_PBPCHUNK * prev; /* Chunk below this one. */
+	size_t size;               /* Bytes of data. */
+	size_t used;               /* Bytes in use. */
+} PBPCHUNK, * P_PBPCHUNK;
+
+/* A worker owns a task deque and a LIFO scratch arena.
+ * The owner pushes and pops tasks at the bottom. Thieves steal them from the top.
+ */
+typedef struct st_PBPWORKER
+{
+	struct st_PBPPOOL * pool;
+	size_t     id;
+	PBPMUTEX   lock;                  /* Guards deque, top and bottom. */
+	P_PBPTASK  deque[PBP_DEQUE_SIZE];
+	size_t     top;
+	size_t     bottom;
+	P_PBPCHUNK arena;                 /* Chunk on the top. */
+	P_PBPCHUNK spare;                 /* Released chunk kept for the next allocation. */
+	PBPTHREAD  thread;
+} PBPWORKER;
+
+/* Worker 0 is borrowed by the thread who enters the pool. The others run in their own threads. */
+typedef struct st_PBPPOOL
+{
+	size_t      workers;
+	size_t      pending; /* Tasks waiting in all deques. */
+	bool        bstop;
+	PBPMUTEX    lock;    /* Guards pending, bstop and done flags of tasks. */
+	PBPMUTEX    entry;   /* Held while worker 0 is in use. */
+	PBPCOND     cond;    /* Idle workers sleep on it. */
+	PBPWORKER * worker;
+} PBPPOOL, * P_PBPPOOL;
+
+static P_PBPPOOL _pbpPool = NULL;
+
+/* File level function declarations. */
+#ifdef _WIN32
+static DWORD WINAPI _pbpThread (LPVOID arg);
+#else
+static void *       _pbpThread (void * arg);
+#endif
+static P_PBPTASK    _pbpPop      (P_PBPWORKER pw);
+static P_PBPTASK    _pbpSteal    (P_PBPWORKER pw);
+static void         _pbpRun      (P_PBPWORKER pw, P_PBPTASK pt);
+static void         _pbpDestroy  (P_PBPPOOL pool, size_t threads);
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbpThread
+ * Description:   Main loop of a worker thread.
+ * Parameters:
+ *        arg Pointer to the worker.
+ * Return value:  Zero.
+ */
+#ifdef _WIN32
+static DWORD WINAPI _pbpThread(LPVOID arg)
+#else
+static void * _pbpThread(void * arg)
+#endif
+{
+	P_PBPWORKER pw = (P_PBPWORKER)arg;
+	P_PBPPOOL pool = pw->pool;
+	P_PBPTASK pt;
+
+	for ( ;; )
+	{
+		PBP_LOCK(&pool->lock);
+		while (!pool->bstop && 0 == pool->pending)
+			PBP_WAIT(&pool->cond, &pool->lock);
+		if (pool->bstop)
+		{
+			PBP_UNLOCK(&pool->lock);
+			break;
+		}
+		PBP_UNLOCK(&pool->lock);
+
+		if (NULL != (pt = _pbpSteal(pw)))
+			_pbpRun(pw, pt);
+		else
+			PBP_YIELD();
+	}
+	return 0;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbpPop
+ * Description:   Pop the newest task of a worker's own deque.
+ * Parameters:
+ *         pw Pointer to the worker.
+ * Return value:  Pointer to the task or NULL if the deque is empty.
+ */
+static P_PBPTASK _pbpPop(P_PBPWORKER pw)
+{
+	P_PBPTASK pt = NULL;
+
+	PBP_LOCK(&pw->lock);
+	if (pw->bottom > pw->top)
+	{
+		pt = pw->deque[--pw->bottom];
+		if (pw->bottom == pw->top)
+			pw->top = pw->bottom = 0;
+	}
+	PBP_UNLOCK(&pw->lock);
+
+	if (NULL != pt)
+	{
+		PBP_LOCK(&pw->pool->lock);
+		--pw->pool->pending;
+		PBP_UNLOCK(&pw->pool->lock);
+	}
+	return pt;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbpSteal
+ * Description:   Steal the oldest task from other workers.
+ * Parameters:
+ *         pw Pointer to the thief.
+ * Return value:  Pointer to the task or NULL if no task is found.
+ * Tip:           Victims are visited from the worker next to the thief.
+ */
+static P_PBPTASK _pbpSteal(P_PBPWORKER pw)
+{
+	register size_t i;
+	P_PBPPOOL pool = pw->pool;
+	P_PBPWORKER pv;
+	P_PBPTASK pt = NULL;
+
+	for (i = 1; i < pool->workers && NULL == pt; ++i)
+	{
+		pv = &pool->worker[(pw->id + i) % pool->workers];
+		PBP_LOCK(&pv->lock);
+		if (pv->bottom > pv->top)
+		{
+			pt = pv->deque[pv->top++];
+			if (pv->bottom == pv->top)
+				pv->top = pv->bottom = 0;
+		}
+		PBP_UNLOCK(&pv->lock);
+	}
+
+	if (NULL != pt)
+	{
+		PBP_LOCK(&pool->lock);
+		--pool->pending;
+		PBP_UNLOCK(&pool->lock);
+	}
+	return pt;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbpRun
+ * Description:   Run a task and mark it done.
+ * Parameters:
+ *         pw Pointer to the worker who runs the task.
+ *         pt Pointer to the task.
+ * Return value:  N/A.
+ */
+static void _pbpRun(P_PBPWORKER pw, P_PBPTASK pt)
+{
+	pt->func(pt->arg, pw);
+	PBP_LOCK(&pw->pool->lock);
+	pt->done = true;
+	PBP_UNLOCK(&pw->pool->lock);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbpDestroy
+ * Description:   Stop worker threads and free a pool.
+ * Parameters:
+ *       pool Pointer to the pool.
+ *    threads Number of started worker threads.
+ * Return value:  N/A.
+ */
+static void _pbpDestroy(P_PBPPOOL pool, size_t threads)
+{
+	register size_t i;
+	P_PBPCHUNK pc;
+
+	PBP_LOCK(&pool->lock);
+	pool->bstop = true;
+	PBP_BROADCAST(&pool->cond);
+	PBP_UNLOCK(&pool->lock);
+
+	for (i = 1; i <= threads; ++i)
+		PBP_WAITTHREAD(pool->worker[i].thread);
+
+	for (i = 0; i < pool->workers; ++i)
+	{
+		while (NULL != (pc = pool->worker[i].arena))
+		{
+			pool->worker[i].arena = pc->prev;
+			free(pc);
+		}
+		free(pool->worker[i].spare);
+		PBP_MUTEX_FREE(&pool->worker[i].lock);
+	}
+	PBP_COND_FREE(&pool->cond);
+	PBP_MUTEX_FREE(&pool->entry);
+	PBP_MUTEX_FREE(&pool->lock);
+	free(pool->worker);
+	free(pool);
+}
+
+/* Function name: pbpStartPool
+ * Description:   Start the worker pool.
+ * Parameters:
+ *    workers Number of workers including the thread who calls the library.
+ * Return value:  true:  Succeeded.
+ *                false: Failed, the pool is already running or workers < 2.
+ * Caution:       Call this function before any other thread uses the library.
+ * Tip:           The number of processors is a good choice of workers.
+ */
+bool pbpStartPool(size_t workers)
+{
+	register size_t i, j;
+	P_PBPPOOL pool;
+
+	if (NULL != _pbpPool || workers < 2)
+		return false;
+
+	if (NULL == (pool = (P_PBPPOOL)calloc(1, sizeof(PBPPOOL))))
+		return false;
+	if (NULL == (pool->worker = (PBPWORKER *)calloc(workers, sizeof(PBPWORKER))))
+		goto Lbl_Bad_Pool;
+	if (!PBP_MUTEX_INIT(&pool->lock))
+		goto Lbl_Bad_Worker;
+	if (!PBP_MUTEX_INIT(&pool->entry))
+		goto Lbl_Bad_Lock;
+	if (!PBP_COND_INIT(&pool->cond))
+		goto Lbl_Bad_Entry;
+	for (i = 0; i < workers; ++i)
+	{
+		pool->worker[i].pool = pool;
+		pool->worker[i].id = i;
+		if (!PBP_MUTEX_INIT(&pool->worker[i].lock))
+			goto Lbl_Bad_Workers;
+	}
+	pool->workers = workers;
+
+	for (j = 1; j < workers; ++j)
+	{
+		if (!PBP_CREATE(&pool->worker[j].thread, &pool->worker[j]))
+		{
+			_pbpDestroy(pool, j - 1);
+			return false;
+		}
+	}
+
+	_pbpPool = pool;
+	return true;
+
+Lbl_Bad_Workers:
+	while (i > 0)
+		PBP_MUTEX_FREE(&pool->worker[--i].lock);
+	PBP_COND_FREE(&pool->cond);
+Lbl_Bad_Entry:
+	PBP_MUTEX_FREE(&pool->entry);
+Lbl_Bad_Lock:
+	PBP_MUTEX_FREE(&pool->lock);
+Lbl_Bad_Worker:
+	free(pool->worker);
+Lbl_Bad_Pool:
+	free(pool);
+	return false;
+}
+
+/* Function name: pbpStopPool
+ * Description:   Stop the worker pool and free its resources.
+ * Parameters:    N/A.
+ * Return value:  N/A.
+ * Caution:       No thread shall use the library while the pool stops.
+ */
+void pbpStopPool(void)
+{
+	if (NULL != _pbpPool)
+	{
+		_pbpDestroy(_pbpPool, _pbpPool->workers - 1);
+		_pbpPool = NULL;
+	}
+}
+
+/* Function name: pbpEnter
+ * Description:   Borrow worker 0 of the pool for the calling thread.
+ * Parameters:    N/A.
+ * Return value:  Pointer to the worker.
+ *                NULL: The pool is not running or another thread is using it.
+ * Tip:           Call pbpLeave to return the worker.
+ */
+P_PBPWORKER pbpEnter(void)
+{
+	if (NULL != _pbpPool && PBP_TRYLOCK(&_pbpPool->entry))
+		return &_pbpPool->worker[0];
+	return NULL;
+}
+
+/* Function name: pbpLeave
+ * Description:   Return worker 0 to the pool.
+ * Parameters:
+ *         pw Pointer to the worker returned by pbpEnter.
+ * Return value:  N/A.
+ */
+void pbpLeave(P_PBPWORKER pw)
+{
+	PBP_UNLOCK(&pw->pool->entry);
+}
+
+/* Function name: pbpFork
+ * Description:   Push a task so that idle workers can steal it.
+ * Parameters:
+ *         pw Pointer to the current worker.
+ *         pt Pointer to the task.
+ * Return value:  N/A.
+ * Caution:       Every forked task shall be joined by the same worker in reverse order.
+ * Tip:           The task runs at once if the deque is full.
+ */
+void pbpFork(P_PBPWORKER pw, P_PBPTASK pt)
+{
+	register bool bpushed = false;
+
+	pt->done = false;
+	PBP_LOCK(&pw->lock);
+	if (pw->bottom < PBP_DEQUE_SIZE)
+	{
+		pw->deque[pw->bottom++] = pt;
+		bpushed = true;
+	}
+	PBP_UNLOCK(&pw->lock);
+
+	if (bpushed)
+	{
+		PBP_LOCK(&pw->pool->lock);
+		++pw->pool->pending;
+		PBP_SIGNAL(&pw->pool->cond);
+		PBP_UNLOCK(&pw->pool->lock);
+	}
+	else
+		_pbpRun(pw, pt);
+}
+
+/* Function name: pbpJoin
+ * Description:   Wait for a forked task.
+ * Parameters:
+ *         pw Pointer to the current worker.
+ *         pt Pointer to the task.
+ * Return value:  N/A.
+ * Tip:           The worker runs its own and stolen tasks while it waits.
+ */
+void pbpJoin(P_PBPWORKER pw, P_PBPTASK pt)
+{
+	register bool bdone;
+	P_PBPTASK px;
+
+	for ( ;; )
+	{
+		PBP_LOCK(&pw->pool->lock);
+		bdone = pt->done;
+		PBP_UNLOCK(&pw->pool->lock);
+		if (bdone)
+			break;
+
+		if (NULL != (px = _pbpPop(pw)) || NULL != (px = _pbpSteal(pw)))
+			_pbpRun(pw, px);
+		else
+			PBP_YIELD();
+	}
+}
+
+/* Function name: pbpAlloc
+ * Description:   Allocate scratch memory from a worker's arena.
+ * Parameters:
+ *         pw Pointer to the current worker.
+ *       size Bytes to allocate.
+ * Return value:  Pointer to the memory or NULL if allocation failed.
+ * Caution:       Memory shall be freed by pbpFree in reverse order of allocation.
+ */
+void * pbpAlloc(P_PBPWORKER pw, size_t size)
+{
+	register void * p;
+	P_PBPCHUNK pc = pw->arena;
+
+	size = PBP_ALIGN(size);
+	if (NULL == pc || pc->size - pc->used < size)
+	{
+		if (NULL != pw->spare && pw->spare->size >= size)
+		{
+			pc = pw->spare;
+			pw->spare = NULL;
+		}
+		else
+		{
+			register size_t s = GETMAX(size, PBP_CHUNK_SIZE);
+			if (NULL == (pc = (P_PBPCHUNK)malloc(sizeof(PBPCHUNK) + s)))
+				return NULL;
+			pc->size = s;
+		}
+		pc->used = 0;
+		pc->prev = pw->arena;
+		pw->arena = pc;
+	}
+	p = (char *)(pc + 1) + pc->used;
+	pc->used += size;
+	return p;
+}
+
+/* Function name: pbpFree
+ * Description:   Free scratch memory allocated by pbpAlloc.
+ * Parameters:
+ *         pw Pointer to the current worker.
+ *          p Pointer to the memory.
+ * Return value:  N/A.
+ * Tip:           Memory above p in the arena is freed too.
+ */
+void pbpFree(P_PBPWORKER pw, void * p)
+{
+	P_PBPCHUNK pc = pw->arena;
+
+	pc->used = (size_t)((char *)p - (char *)(pc + 1));
+	if (0 == pc->used)
+	{	/* Keep the larger chunk as a spare. */
+		pw->arena = pc->prev;
+		if (NULL == pw->spare || pw->spare->size < pc->size)
+		{
+			free(pw->spare);
+			pw->spare = pc;
+		}
+		else
+			free(pc);
+	}
+}
+
+#else
+
+bool pbpStartPool(size_t workers)
+{
+	(void)workers;
+	return false;
+}
+
+void pbpStopPool(void)
+{
+}
+
+P_PBPWORKER pbpEnter(void)
+{
+	return NULL;
+}
+
+void pbpLeave(P_PBPWORKER pw)
+{
+	(void)pw;
+}
+
+void pbpFork(P_PBPWORKER pw, P_PBPTASK pt)
+{
+	pt->func(pt->arg, pw);
+	pt->done = true;
+}
+
+void pbpJoin(P_PBPWORKER pw, P_PBPTASK pt)
+{
+	(void)pw;
+	(void)pt;
+}
+
+void * pbpAlloc(P_PBPWORKER pw, size_t size)
+{
+	(void)pw;
+	return malloc(size);
+}
+
+void pbpFree(P_PBPWORKER pw, void * p)
+{
+	(void)pw;
+	free(p);
+}
+
+#endif
+
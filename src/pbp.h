@@ -0,0 +1,44 @@
+/*
+ * Name:        pbp.h
+ * Description: Portable big integer library parallel support.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     1019261045A1019261045L00044
+ * License:     GPLv3.
+ */
+
+#ifndef _PBP_H_
+#define _PBP_H_
+
+#include "pbk.h"
+
+/* Define PBK_NO_THREADS on platforms without threads. The pool can not be started then. */
+
+#define PBP_DEQUE_SIZE 64U     /* Maximum pending tasks of each worker. */
+#define PBP_CHUNK_SIZE 262144U /* Bytes of each scratch chunk of a worker. */
+
+/* A worker of the pool. Opaque to users. */
+typedef struct st_PBPWORKER * P_PBPWORKER;
+
+/* Callback of a task. pw is the worker who runs the task. */
+typedef void (* CBF_PBPTASK)(void * arg, P_PBPWORKER pw);
+
+/* A task that can be stolen by other workers. */
+typedef struct st_PBPTASK
+{
+	CBF_PBPTASK func; /* Function to run. */
+	void *      arg;  /* Argument of func. */
+	bool        done; /* true after func returned. */
+} PBPTASK, * P_PBPTASK;
+
+/* Functions for the worker pool. */
+bool        pbpStartPool (size_t workers);
+void        pbpStopPool  (void);
+P_PBPWORKER pbpEnter     (void);
+void        pbpLeave     (P_PBPWORKER pw);
+void        pbpFork      (P_PBPWORKER pw, P_PBPTASK pt);
+void        pbpJoin      (P_PBPWORKER pw, P_PBPTASK pt);
+void *      pbpAlloc     (P_PBPWORKER pw, size_t size);
+void        pbpFree      (P_PBPWORKER pw, void * p);
+
+#endif
+
@@ -2,12 +2,27 @@
  * Name:        pbu.c
  * Description: Portable big integer library utilities.
  * Author:      cosh.cage#hotmail.com
- * File ID:     0930252246B0930252300L00133
+ * File ID:     0930252246B1019261810L00275
  * License:     GPLv3.
  */
 
-#include <string.h> /* Using function memcpy. */
 #include "pbu.h"
+#include <stdlib.h>   /* Using function malloc, free. */
+#include <string.h>   /* Using function memcpy, strcpy. */
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined __unix__ || defined __APPLE__
+#define PBU_MMAP
+#include <fcntl.h>    /* Using function open. */
+#include <sys/mman.h> /* Using function mmap, munmap, madvise. */
+#include <sys/stat.h> /* Using function fstat. */
+#include <unistd.h>   /* Using function close. */
+#endif
+
+static const char * _pbuMapFile   (const char * path, size_t * pn);
+static void         _pbuUnmapFile (const char * p, size_t n);
+static bool         _pbuWriteFile (const char * s, size_t n, void * param);
 
 /* Function name: pbuDecimalSzToBint
  * Description:   Decimal zero terminated string to big integer.
@@ -16,29 +31,177 @@
  *        str Pointer to zero terminated string.
  * Return value:  true:  Succeeded.
  *                false: Failed.
+ * Tip:           The string is converted directly, see pbkDecimalSzToBint.
  */
 bool pbuDecimalSzToBint(P_BINT pbi, const char * str)
 {
-	BNUM n = { 0 };
-	
-	if (!pbkInitBnum(&n, 10))
-		return false;
-	
-	if (!pbkDecimalSzToBnum(&n, str))
+	return pbkDecimalSzToBint(pbi, str);
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbuMapFile
+ * Description:   Map a file into memory for reading.
+ * Parameters:
+ *       path Path of the file.
+ *         pn Pointer to a size_t to store the size of the file.
+ * Return value:  Pointer to the content of the file. Unmap it with _pbuUnmapFile.
+ *                NULL: Failed or the file is empty.
+ * Tip:           Pages are read by the system when they are touched, so no copy is made.
+ *                Without mapping, the file is read into memory.
+ */
+static const char * _pbuMapFile(const char * path, size_t * pn)
+{
+	void * p = NULL;
+#ifdef _WIN32
+	HANDLE hf, hm;
+	LARGE_INTEGER sz;
+
+	if (INVALID_HANDLE_VALUE == (hf = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL)))
+		return NULL;
+	if (GetFileSizeEx(hf, &sz) && sz.QuadPart > 0 && (unsigned long long)sz.QuadPart <= (size_t)-1)
 	{
-		pbkFreeBnum(&n);
-		return false;
+		if (NULL != (hm = CreateFileMappingA(hf, NULL, PAGE_READONLY, 0, 0, NULL)))
+		{
+			p = MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(hm);
+			*pn = (size_t)sz.QuadPart;
+		}
 	}
-		
-	if (!pbkDecimalBnumToBint(pbi, &n))
+	CloseHandle(hf);
+#elif defined PBU_MMAP
+	struct stat st;
+	int fd;
+
+	if (-1 == (fd = open(path, O_RDONLY)))
+		return NULL;
+	if (0 == fstat(fd, &st) && st.st_size > 0 && (unsigned long long)st.st_size <= (size_t)-1)
 	{
-		pbkFreeBnum(&n);
+		p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == p)
+			p = NULL;
+		else
+		{
+#ifdef MADV_SEQUENTIAL
+			madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+			*pn = (size_t)st.st_size;
+		}
+	}
+	close(fd);
+#else
+	FILE * fp;
+	long sz;
+
+	if (NULL == (fp = fopen(path, "rb")))
+		return NULL;
+	if (0 == fseek(fp, 0, SEEK_END) && (sz = ftell(fp)) > 0 && 0 == fseek(fp, 0, SEEK_SET) &&
+		NULL != (p = malloc((size_t)sz)))
+	{
+		if ((size_t)sz != fread(p, 1, (size_t)sz, fp))
+		{
+			free(p);
+			p = NULL;
+		}
+		*pn = (size_t)sz;
+	}
+	fclose(fp);
+#endif
+	return (const char *)p;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbuUnmapFile
+ * Description:   Unmap a file mapped by _pbuMapFile.
+ * Parameters:
+ *          p Pointer to the content of the file.
+ *          n Size of the file.
+ * Return value:  N/A.
+ */
+static void _pbuUnmapFile(const char * p, size_t n)
+{
+#ifdef _WIN32
+	(void)n;
+	UnmapViewOfFile(p);
+#elif defined PBU_MMAP
+	munmap((void *)p, n);
+#else
+	(void)n;
+	free((void *)p);
+#endif
+}
+
+/* Function name: pbuFileToBint
+ * Description:   Read a big integer from a text file.
+ * Parameters:
+ *        pbi Pointer to a big integer.
+ *       path Path of the file.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Caution:       The file shall contain one number only. White spaces around it are skipped.
+ *                A sign may lead the digits, and 0x or 0X if base is 16.
+ * Tip:           The file is mapped into memory and converted where it lies, see pbkSzNToBint.
+ *                If pbpStartPool has been called, a large file is validated and converted by
+ *                all workers.
+ */
+bool pbuFileToBint(P_BINT pbi, const char * path, _ub base)
+{
+	register const char * s;
+	register size_t n;
+	register bool bneg = false, bok;
+	const char * p;
+	size_t l;
+
+	if (NULL == (p = _pbuMapFile(path, &l)))
 		return false;
+
+	for (s = p, n = l; n > 0 && (' ' == s[n - 1] || ('\t' <= s[n - 1] && s[n - 1] <= '\r')); --n)
+		;
+	for (; n > 0 && (' ' == *s || ('\t' <= *s && *s <= '\r')); ++s, --n)
+		;
+	if (n > 0 && ('-' == *s || '+' == *s))
+	{
+		bneg = '-' == *s;
+		++s, --n;
 	}
-		
-	pbkFreeBnum(&n);
-	
-	return true;
+	if (16 == base && n > 2 && '0' == s[0] && ('x' == s[1] || 'X' == s[1]))
+		s += 2, n -= 2;
+
+	if ((bok = pbkSzNToBint(pbi, s, n, base)) && bneg && !pbkIsBintEqualToZero(pbi))
+		SETFLAG(pbi, -GETFLAG(pbi));
+
+	_pbuUnmapFile(p, l);
+	return bok;
+}
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbuWriteFile
+ * Description:   Callback of pbkBintToStream that writes characters to a file.
+ * Parameters:
+ *          s Pointer to characters.
+ *          n Number of characters.
+ *      param Pointer to a file.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ */
+static bool _pbuWriteFile(const char * s, size_t n, void * param)
+{
+	return n == fwrite(s, 1, n, (FILE *)param);
+}
+
+/* Function name: pbuFPrintBint
+ * Description:   Print a big integer to a file in a base.
+ * Parameters:
+ *         fp Pointer to a file.
+ *        pbi Pointer to a big integer.
+ *       base Base of digits. 2 - 36.
+ * Return value:  true:  Succeeded.
+ *                false: Failed.
+ * Tip:           The digits are streamed to fp BINT_STREAM_SIZE at a time, see pbkBintToStream.
+ */
+bool pbuFPrintBint(FILE * fp, P_BINT pbi, _ub base)
+{
+	return pbkBintToStream(pbi, base, _pbuWriteFile, fp);
 }
 
 /* Function name: pbuFPrintDecimalBint
@@ -48,35 +211,11 @@ bool pbuDecimalSzToBint(P_BINT pbi, const char * str)
  *        pbi Pointer to a big integer.
  * Return value:  true:  Succeeded.
  *                false: Failed.
+ * Tip:           The decimal string is never held in memory at once, see pbuFPrintBint.
  */
 bool pbuFPrintDecimalBint(FILE * fp, P_BINT pbi)
 {
-	BNUM n = { 0 };
-	
-	if (!pbkInitBnum(&n, 10))
-		return false;
-	
-	if (!pbkBintToDecimalBnum(&n, pbi))
-	{
-		pbkFreeBnum(&n);
-		return false;
-	}
-	
-	if (pbkIsNotANumber(pbi))
-		fprintf(fp, "NaN");
-	else
-	{
-		register size_t i;
-		
-		if (GETFLAG(pbi) < 0)
-			fputc('-', fp);
-		
-		for (i = GETABS(GETFLAG(&n)); i > 0; --i)
-			fputc('0' + n.data[i - 1], fp);
-	}
-	
-	pbkFreeBnum(&n);
-	return true;
+	return pbuFPrintBint(fp, pbi, 10);
 }
 
 /* Function name: pbuPrintDecimalBint
@@ -98,36 +237,39 @@ bool pbuPrintDecimalBint(P_BINT pbi)
  *        pbi Pointer to a big integer.
  * Return value:  true:  Succeeded.
  *                false: Failed.
+ * Caution:       str must hold the whole decimal string and a terminating zero.
+ * Tip:           A NaN is printed as "NaN" and true is returned. Earlier versions returned false
+ *                for a NaN and left str untouched.
+ *                The digits are converted into a new string and then copied, so that
+ *                str needs not hold the estimate of pbkBintSzLength.
  */
 bool pbuSPrintDecimalBint(char * str, P_BINT pbi)
 {
-	BNUM n = { 0 };
-	
-	if (!pbkInitBnum(&n, 10))
-		return false;
-	
-	if (!pbkBintToDecimalBnum(&n, pbi))
-	{
-		pbkFreeBnum(&n);
-		return false;
-	}
-	
+	char * s;
+
 	if (pbkIsNotANumber(pbi))
-		memcpy(str, "NaN", 4);
-	else
 	{
-		register size_t i;
-		
-		if (GETFLAG(pbi) < 0)
-			*str++ = '-';
-		
-		for (i = GETABS(GETFLAG(&n)); i > 0; --i)
-			*str++ = (char)'0' + n.data[i - 1];
-		
-		*str = '\0';
+		memcpy(str, "NaN", 4);
+		return true;
 	}
-	
-	pbkFreeBnum(&n);
+	if (NULL == (s = pbkBintToDecimalSz(pbi)))
+		return false;
+	strcpy(str, s);
+	free(s);
 	return true;
 }
 
+/* Function name: pbuSNPrintDecimalBint
+ * Description:   Print a big integer to a character string of a size.
+ * Parameters:
+ *        str Pointer to a string.
+ *       size Capacity of str including the terminating zero.
+ *        pbi Pointer to a big integer.
+ * Return value:  Length of the whole decimal string. 0: Failed.
+ * Tip:           Works like snprintf. See pbkBintToSzN.
+ */
+size_t pbuSNPrintDecimalBint(char * str, size_t size, P_BINT pbi)
+{
+	return pbkBintToSzN(str, size, pbi, 10);
+}
+
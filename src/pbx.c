@@ -1,97 +1,192 @@
-/*
- * Name:        pbx.c
- * Description: Portable big integer library eXternal memory support.
- * Author:      cosh.cage#hotmail.com
- * File ID:     0520240323F0520240555L00097
- * License:     GPLv3.
- */
-
-#include "pbx.h"
-#include <string.h>
-
-#define pbxMagic "Pb" /* Magical number. */
-
-static _ub _pbxGetPlatformSize(void);
-
-/* Attention:     This Is An Internal Function. No Interface for Library Users.
- * Function name: _pbxGetPlatformSize
- * Description:   Return sizeof(_ub).
- * Parameters:    N/A.
- * Return value:  sizeof(_ub).
- * Tip:           To inline this function is a better choice.
- */
-static _ub _pbxGetPlatformSize(void)
-{
-	return sizeof(_ub);
-}
-
-/* Function name: pbxLoadBint
- * Description:   Load a big integer from a file.
- * Parameters:
- *        pbi Pointer to a big integer.
- *         fp Pointer to an opened file structure.
- * Return value:  Please reference to enumeration PBXERR.
- * Tip:           Big integer structure shall be initialized to 0.
- */
-PBXERR pbxLoadBint(P_BINT pbi, FILE * fp)
-{
-	if (NULL != fp)
-	{
-		XBINT xb = { 0 };
-		fread(&xb, sizeof(XBINT), 1, fp);
-		if (memcmp(pbxMagic, xb.magic, sizeof(xb.magic)) == 0)
-		{
-			if (_pbxGetPlatformSize() == xb.pflg)
-			{
-				if (pbkReallocBint(pbi, (_ub)GETABS(xb.flag), true))
-				{
-					register size_t i = GETABS(GETFLAG(&xb)), j;
-
-					for (j = 0; j < i; ++j)
-						fread(&pbi->data[j], sizeof(_ub), 1, fp);
-					
-					SETFLAG(pbi, xb.flag);
-					SETINCL(pbi, xb.incl);
-					return PXE_NONE;
-				}
-				return PXE_ALLOCATION;
-			}
-			return PXE_WRONG_PLATF;
-		}
-		return PXE_BAD_FORMAT;
-	}
-	return PXE_BAD_FILE;
-}
-
-/* Function name: pbxSaveBint
- * Description:   Save a big integer to a file.
- * Parameters:
- *         fp Pointer to an opened file structure.
- *        pbi Pointer to a big integer.
- * Return value:  Please reference to enumeration PBXERR.
- */
-PBXERR pbxSaveBint(FILE * fp, P_BINT pbi)
-{
-	if (NULL != fp)
-	{
-		if (NULL != pbi)
-		{
-			register size_t i, j;
-			XBINT xb = { 0 };
-			memcpy(xb.magic, pbxMagic, sizeof(xb.magic));
-			xb.flag = GETFLAG(pbi);
-			xb.incl = GETINCL(pbi);
-			xb.pflg = _pbxGetPlatformSize();
-
-			fwrite(&xb, sizeof(XBINT), 1, fp);
-			j = GETABS(GETFLAG(pbi));
-			for (i = 0; i < j; ++i)
-				fwrite(pbi->data + i, sizeof(_ub), 1, fp);
-
-			return PXE_NONE;
-		}
-		return PXE_ALLOCATION;
-	}
-	return PXE_BAD_FILE;
-}
-
+/*
+ * Name:        pbx.c
+ * Description: Portable big integer library eXternal memory support.
+ * Author:      cosh.cage#hotmail.com
+ * File ID:     0520240323F1019261445L00192
+ * License:     GPLv3.
+ */
+
+#include "pbx.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define pbxMagic "Pb" /* Magical number. */
+#define pbxPowMagic "Pp" /* Magical number of power files. */
+
+static _ub _pbxGetPlatformSize(void);
+
+/* Attention:     This Is An Internal Function. No Interface for Library Users.
+ * Function name: _pbxGetPlatformSize
+ * Description:   Return sizeof(_ub).
+ * Parameters:    N/A.
+ * Return value:  sizeof(_ub).
+ * Tip:           To inline this function is a better choice.
+ */
+static _ub _pbxGetPlatformSize(void)
+{
+	return sizeof(_ub);
+}
+
+/* Function name: pbxLoadBint
+ * Description:   Load a big integer from a file.
+ * Parameters:
+ *        pbi Pointer to a big integer.
+ *         fp Pointer to an opened file structure.
+ * Return value:  Please reference to enumeration PBXERR.
+ * Tip:           Big integer structure shall be initialized to 0.
+ */
+PBXERR pbxLoadBint(P_BINT pbi, FILE * fp)
+{
+	if (NULL != fp)
+	{
+		XBINT xb = { 0 };
+		fread(&xb, sizeof(XBINT), 1, fp);
+		if (memcmp(pbxMagic, xb.magic, sizeof(xb.magic)) == 0)
+		{
+			if (_pbxGetPlatformSize() == xb.pflg)
+			{
+				if (pbkReallocBint(pbi, (_ub)GETABS(xb.flag), true))
+				{
+					register size_t i = GETABS(GETFLAG(&xb)), j;
+
+					for (j = 0; j < i; ++j)
+						fread(&pbi->data[j], sizeof(_ub), 1, fp);
+					
+					SETFLAG(pbi, xb.flag);
+					SETINCL(pbi, xb.incl);
+					return PXE_NONE;
+				}
+				return PXE_ALLOCATION;
+			}
+			return PXE_WRONG_PLATF;
+		}
+		return PXE_BAD_FORMAT;
+	}
+	return PXE_BAD_FILE;
+}
+
+/* Function name: pbxSaveBint
+ * Description:   Save a big integer to a file.
+ * Parameters:
+ *         fp Pointer to an opened file structure.
+ *        pbi Pointer to a big integer.
+ * Return value:  Please reference to enumeration PBXERR.
+ */
+PBXERR pbxSaveBint(FILE * fp, P_BINT pbi)
+{
+	if (NULL != fp)
+	{
+		if (NULL != pbi)
+		{
+			register size_t i, j;
+			XBINT xb = { 0 };
+			memcpy(xb.magic, pbxMagic, sizeof(xb.magic));
+			xb.flag = GETFLAG(pbi);
+			xb.incl = GETINCL(pbi);
+			xb.pflg = _pbxGetPlatformSize();
+
+			fwrite(&xb, sizeof(XBINT), 1, fp);
+			j = GETABS(GETFLAG(pbi));
+			for (i = 0; i < j; ++i)
+				fwrite(pbi->data + i, sizeof(_ub), 1, fp);
+
+			return PXE_NONE;
+		}
+		return PXE_ALLOCATION;
+	}
+	return PXE_BAD_FILE;
+}
+
+/* Function name: pbxLoadPowers
+ * Description:   Load powers for radix conversion from a file.
+ * Parameters:
+ *         fp Pointer to an opened file structure.
+ * Return value:  Please reference to enumeration PBXERR.
+ * Tip:           Conversions in the base of the file start without computing the powers.
+ *                Each power is checked by pbkPutPower before it is used.
+ */
+PBXERR pbxLoadPowers(FILE * fp)
+{
+	if (NULL != fp)
+	{
+		XPOW xp = { 0 };
+		if (1 == fread(&xp, sizeof(XPOW), 1, fp) && memcmp(pbxPowMagic, xp.magic, sizeof(xp.magic)) == 0)
+		{
+			if (_pbxGetPlatformSize() == xp.pflg)
+			{
+				register size_t i, l = 0;
+				PBXERR r = PXE_NONE;
+				_ub * p = NULL, h[2];
+				PBKPOWER pp;
+
+				for (i = 0; PXE_NONE == r && i < xp.count; ++i)
+				{
+					_ub * t;
+					/* Each power has twice or twice less one the blocks of the last. */
+					if (2 != fread(h, sizeof(_ub), 2, fp) || (0 == i ? 1 != h[0] : (h[0] + 1) / 2 != l))
+						r = PXE_BAD_FORMAT;
+					else if (NULL == (t = (_ub *)realloc(p, (2 * (size_t)h[0] + 1) * sizeof(_ub))))
+						r = PXE_ALLOCATION;
+					else
+					{
+						p = t;
+						pp.p = p;
+						pp.n = l = h[0];
+						pp.x = 0 != h[1] ? p + pp.n : NULL;
+						if (pp.n != fread(p, sizeof(_ub), pp.n, fp) ||
+							(NULL != pp.x && pp.n + 1 != fread(p + pp.n, sizeof(_ub), pp.n + 1, fp)))
+							r = PXE_BAD_FILE;
+						else if (!pbkPutPower(xp.base, i, &pp))
+							r = PXE_BAD_FORMAT;
+					}
+				}
+				free(p);
+				return r;
+			}
+			return PXE_WRONG_PLATF;
+		}
+		return PXE_BAD_FORMAT;
+	}
+	return PXE_BAD_FILE;
+}
+
+/* Function name: pbxSavePowers
+ * Description:   Save powers for radix conversion to a file.
+ * Parameters:
+ *         fp Pointer to an opened file structure.
+ *       base Base of digits. 2 - 36.
+ *     digits Number of digits of the greatest number to convert. See pbkPreparePowers.
+ * Return value:  Please reference to enumeration PBXERR.
+ */
+PBXERR pbxSavePowers(FILE * fp, _ub base, size_t digits)
+{
+	if (NULL != fp)
+	{
+		if (pbkPreparePowers(base, digits))
+		{
+			register size_t i;
+			_ub h[2];
+			PBKPOWER pp;
+			XPOW xp = { 0 };
+			memcpy(xp.magic, pbxPowMagic, sizeof(xp.magic));
+			xp.pflg = _pbxGetPlatformSize();
+			xp.base = base;
+			while (pbkGetPower(&pp, base, xp.count))
+				++xp.count;
+
+			fwrite(&xp, sizeof(XPOW), 1, fp);
+			for (i = 0; i < xp.count && pbkGetPower(&pp, base, i); ++i)
+			{
+				h[0] = (_ub)pp.n;
+				h[1] = NULL != pp.x;
+				fwrite(h, sizeof(_ub), 2, fp);
+				fwrite(pp.p, sizeof(_ub), pp.n, fp);
+				if (NULL != pp.x)
+					fwrite(pp.x, sizeof(_ub), pp.n + 1, fp);
+			}
+			return PXE_NONE;
+		}
+		return PXE_ALLOCATION;
+	}
+	return PXE_BAD_FILE;
+}